@@ -466,6 +466,8 @@ struct hash
     ULONG             secret_len;
     hash_state        outer;
     hash_state        inner;
+    hash_state        outer_init;
+    hash_state        inner_init;
 };
 
 #define BLOCK_LENGTH_RC4        1
@@ -957,7 +959,11 @@ static void hash_prepare( struct hash *hash )
 
     /* initialize hash */
     hash->desc->init( &hash->inner );
-    if (!(hash->flags & HASH_FLAG_HMAC)) return;
+    if (!(hash->flags & HASH_FLAG_HMAC))
+    {
+        hash->inner_init = hash->inner;
+        return;
+    }
 
     /* initialize hmac */
     hash->desc->init( &hash->outer );
@@ -975,6 +981,16 @@ static void hash_prepare( struct hash *hash )
     hash->desc->process( &hash->outer, buffer, block_bytes );
     for (i = 0; i < block_bytes; i++) buffer[i] ^= (0x5c ^ 0x36);
     hash->desc->process( &hash->inner, buffer, block_bytes );
+
+    /* keep the keyed states around so that resetting doesn't need to process the key again */
+    hash->outer_init = hash->outer;
+    hash->inner_init = hash->inner;
+}
+
+static void hash_reset( struct hash *hash )
+{
+    hash->inner = hash->inner_init;
+    if (hash->flags & HASH_FLAG_HMAC) hash->outer = hash->outer_init;
 }
 
 static NTSTATUS hash_create( const struct algorithm *alg, UCHAR *secret, ULONG secret_len, ULONG flags,
@@ -1094,7 +1110,7 @@ static void hash_finalize( struct hash *hash, UCHAR *output )
     if (!(hash->flags & HASH_FLAG_HMAC))
     {
         hash->desc->done( &hash->inner, output );
-        if (hash->flags & HASH_FLAG_REUSABLE) hash_prepare( hash );
+        if (hash->flags & HASH_FLAG_REUSABLE) hash_reset( hash );
         return;
     }
 
@@ -1102,7 +1118,7 @@ static void hash_finalize( struct hash *hash, UCHAR *output )
     hash->desc->process( &hash->outer, buffer, hash->desc->hashsize );
     hash->desc->done( &hash->outer, output );
 
-    if (hash->flags & HASH_FLAG_REUSABLE) hash_prepare( hash );
+    if (hash->flags & HASH_FLAG_REUSABLE) hash_reset( hash );
 }
 
 NTSTATUS WINAPI BCryptFinishHash( BCRYPT_HASH_HANDLE handle, UCHAR *output, ULONG size, ULONG flags )
@@ -2540,11 +2556,11 @@ NTSTATUS WINAPI BCryptDeriveKeyCapi( BCRYPT_HASH_HANDLE handle, BCRYPT_ALG_HANDL
             pad2[i] = 0x5c ^ (i < len ? buf[i] : 0);
         }
 
-        hash_prepare( hash );
+        hash_reset( hash );
         hash->desc->process( &hash->inner, pad1, sizeof(pad1) );
         hash_finalize( hash, buf );
 
-        hash_prepare( hash );
+        hash_reset( hash );
         hash->desc->process( &hash->inner, pad2, sizeof(pad2) );
         hash_finalize( hash, buf + len );
     }
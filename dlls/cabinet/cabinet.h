@@ -22,6 +22,7 @@
 #define __WINE_CABINET_H
 
 #include <stdarg.h>
+#include <zlib.h>
 
 #include "windef.h"
 #include "winbase.h"
@@ -102,31 +103,11 @@ typedef UINT32        cab_off_t;
 
 /* MSZIP stuff */
 #define ZIPWSIZE 	0x8000  /* window size */
-#define ZIPLBITS	9	/* bits in base literal/length lookup table */
-#define ZIPDBITS	6	/* bits in base distance lookup table */
-#define ZIPBMAX		16      /* maximum bit length of any code */
-#define ZIPN_MAX	288     /* maximum number of codes in any set */
-
-struct Ziphuft {
-  cab_UBYTE e;                /* number of extra bits or operation */
-  cab_UBYTE b;                /* number of bits in this code or subcode */
-  union {
-    cab_UWORD n;              /* literal, length base, or distance base */
-    struct Ziphuft *t;        /* pointer to next level of table */
-  } v;
-};
 
 struct ZIPstate {
-    cab_ULONG window_posn;      /* current offset within the window        */
-    cab_ULONG bb;               /* bit buffer */
-    cab_ULONG bk;               /* bits in bit buffer */
-    cab_ULONG ll[288+32];       /* literal/length and distance code lengths */
-    cab_ULONG c[ZIPBMAX+1];     /* bit length count table */
-    cab_LONG  lx[ZIPBMAX+1];    /* memory for l[-1..ZIPBMAX-1] */
-    struct Ziphuft *u[ZIPBMAX];	/* table stack */
-    cab_ULONG v[ZIPN_MAX];      /* values in order of bit length */
-    cab_ULONG x[ZIPBMAX+1];     /* bit offsets, then code stack */
-    cab_UBYTE *inpos;
+    z_stream stream;            /* inflate state, kept for the whole folder */
+    BOOL stream_init;           /* whether the stream has been initialized  */
+    cab_ULONG window_len;       /* size of the previous block's output     */
 };
   
 /* Quantum stuff */
@@ -462,29 +443,6 @@ typedef struct cds_forward {
   bitbuf = lb.bb; bitsleft = lb.bl; inpos = lb.ip; \
 } while (0)
 
-/* Tables for deflate from PKZIP's appnote.txt. */
-
-#define THOSE_ZIP_CONSTS                                                           \
-static const cab_UBYTE Zipborder[] = /* Order of the bit length code lengths */    \
-{ 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};               \
-static const cab_UWORD Zipcplens[] = /* Copy lengths for literal codes 257..285 */ \
-{ 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51,             \
- 59, 67, 83, 99, 115, 131, 163, 195, 227, 258, 0, 0};                              \
-static const cab_UWORD Zipcplext[] = /* Extra bits for literal codes 257..285 */   \
-{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4,             \
-  4, 5, 5, 5, 5, 0, 99, 99}; /* 99==invalid */                                     \
-static const cab_UWORD Zipcpdist[] = /* Copy offsets for distance codes 0..29 */   \
-{ 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,             \
-513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};          \
-static const cab_UWORD Zipcpdext[] = /* Extra bits for distance codes */           \
-{ 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,            \
-10, 11, 11, 12, 12, 13, 13};                                                       \
-/* And'ing with Zipmask[n] masks the lower n bits */                               \
-static const cab_UWORD Zipmask[17] = {                                             \
- 0x0000, 0x0001, 0x0003, 0x0007, 0x000f, 0x001f, 0x003f, 0x007f, 0x00ff,           \
- 0x01ff, 0x03ff, 0x07ff, 0x0fff, 0x1fff, 0x3fff, 0x7fff, 0xffff                    \
-}
-
 /* SESSION Operation */
 #define EXTRACT_FILLFILELIST  0x00000001
 #define EXTRACT_EXTRACTFILES  0x00000002
@@ -18,17 +18,276 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
  */
 
+#include <stdarg.h>
+#include <stdlib.h>
+
+#include "windef.h"
+#include "winbase.h"
 #include "compressapi.h"
 #include "wine/debug.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(cabinet);
 
+#define XPRESS_HASH_BITS    13
+#define XPRESS_MAX_OFFSET   8192
+#define XPRESS_MIN_MATCH    3
+#define XPRESS_MAX_MATCH    0xffff
+
+struct compressor
+{
+    DWORD algorithm;
+    BOOL  raw;
+    COMPRESS_ALLOCATION_ROUTINES routines;
+    SIZE_T *hash;   /* match finder workspace, reused by every Compress call */
+};
+
+struct decompressor
+{
+    DWORD algorithm;
+    BOOL  raw;
+    COMPRESS_ALLOCATION_ROUTINES routines;
+};
+
+static void *compress_alloc( const COMPRESS_ALLOCATION_ROUTINES *routines, SIZE_T size )
+{
+    if (routines->Allocate) return routines->Allocate( routines->UserContext, size );
+    return malloc( size );
+}
+
+static void compress_free( const COMPRESS_ALLOCATION_ROUTINES *routines, void *ptr )
+{
+    if (routines->Free) routines->Free( routines->UserContext, ptr );
+    else free( ptr );
+}
+
+static BOOL is_valid_algorithm( DWORD algorithm )
+{
+    algorithm &= ~COMPRESS_RAW;
+    return algorithm >= COMPRESS_ALGORITHM_MSZIP && algorithm < COMPRESS_ALGORITHM_MAX;
+}
+
+static UINT xpress_hash( const BYTE *p )
+{
+    return ((p[0] | (p[1] << 8) | (p[2] << 16)) * 2654435761u) >> (32 - XPRESS_HASH_BITS);
+}
+
+static BOOL xpress_put( BYTE *dst, SIZE_T dst_size, SIZE_T *pos, UINT value, unsigned int bytes )
+{
+    if (dst_size - *pos < bytes) return FALSE;
+    while (bytes--)
+    {
+        dst[(*pos)++] = value;
+        value >>= 8;
+    }
+    return TRUE;
+}
+
+static SIZE_T xpress_bound( SIZE_T size )
+{
+    /* all literals, plus one flags word per 32 of them and the final one */
+    return size + (size / 32 + 1) * 4;
+}
+
+/* plain LZ77 XPRESS, as described in [MS-XCA] 2.3 */
+static DWORD xpress_compress( struct compressor *compressor, const BYTE *src, SIZE_T src_size,
+                              BYTE *dst, SIZE_T dst_size, SIZE_T *ret_size )
+{
+    SIZE_T *hash = compressor->hash, pos = 0, out = 4, flags_pos = 0, half_byte_pos = 0;
+    UINT flags = 0, flag_count = 0;
+
+    if (dst_size < 4) return ERROR_INSUFFICIENT_BUFFER;
+    memset( hash, 0, sizeof(*hash) << XPRESS_HASH_BITS );
+
+    while (pos < src_size)
+    {
+        SIZE_T len = 0, offset = 0, i;
+
+        if (src_size - pos >= XPRESS_MIN_MATCH)
+        {
+            UINT h = xpress_hash( src + pos );
+            SIZE_T cand = hash[h];
+
+            /* positions are stored biased by one, so that zero means no entry */
+            hash[h] = pos + 1;
+            if (cand && pos - (cand - 1) <= XPRESS_MAX_OFFSET)
+            {
+                offset = pos - --cand;
+                while (len < XPRESS_MAX_MATCH && pos + len < src_size && src[cand + len] == src[pos + len]) len++;
+            }
+        }
+
+        if (len >= XPRESS_MIN_MATCH)
+        {
+            SIZE_T extra = len - XPRESS_MIN_MATCH;
+
+            if (!xpress_put( dst, dst_size, &out, ((offset - 1) << 3) | min( extra, 7 ), 2 ))
+                return ERROR_INSUFFICIENT_BUFFER;
+            if (extra >= 7)
+            {
+                extra -= 7;
+                if (!half_byte_pos)
+                {
+                    half_byte_pos = out;
+                    if (!xpress_put( dst, dst_size, &out, min( extra, 15 ), 1 )) return ERROR_INSUFFICIENT_BUFFER;
+                }
+                else
+                {
+                    dst[half_byte_pos] |= min( extra, 15 ) << 4;
+                    half_byte_pos = 0;
+                }
+                if (extra >= 15)
+                {
+                    extra -= 15;
+                    if (extra < 255)
+                    {
+                        if (!xpress_put( dst, dst_size, &out, extra, 1 )) return ERROR_INSUFFICIENT_BUFFER;
+                    }
+                    else if (!xpress_put( dst, dst_size, &out, 255, 1 ) ||
+                             !xpress_put( dst, dst_size, &out, extra + 15 + 7, 2 ))
+                        return ERROR_INSUFFICIENT_BUFFER;
+                }
+            }
+
+            for (i = 1; i < len && src_size - (pos + i) >= XPRESS_MIN_MATCH; i++)
+                hash[xpress_hash( src + pos + i )] = pos + i + 1;
+            flags = (flags << 1) | 1;
+            pos += len;
+        }
+        else
+        {
+            if (!xpress_put( dst, dst_size, &out, src[pos++], 1 )) return ERROR_INSUFFICIENT_BUFFER;
+            flags <<= 1;
+        }
+
+        if (++flag_count == 32)
+        {
+            xpress_put( dst, dst_size, &flags_pos, flags, 4 );
+            flags_pos = out;
+            if (!xpress_put( dst, dst_size, &out, 0, 4 )) return ERROR_INSUFFICIENT_BUFFER;
+            flags = flag_count = 0;
+        }
+    }
+
+    /* the unused flags are set, so that the decoder sees a match with no input left */
+    flags = flag_count ? (flags << (32 - flag_count)) | ((1u << (32 - flag_count)) - 1) : ~0u;
+    xpress_put( dst, dst_size, &flags_pos, flags, 4 );
+    *ret_size = out;
+    return ERROR_SUCCESS;
+}
+
+static DWORD xpress_decompress( const BYTE *src, SIZE_T src_size, BYTE *dst, SIZE_T dst_size, SIZE_T *ret_size )
+{
+    SIZE_T in = 0, out = 0, half_byte_pos = 0, len, offset;
+    UINT flags = 0, flag_count = 0;
+
+    for (;;)
+    {
+        if (!flag_count)
+        {
+            if (in == src_size) break;
+            if (src_size - in < 4) return ERROR_BAD_COMPRESSION_BUFFER;
+            flags = src[in] | (src[in + 1] << 8) | (src[in + 2] << 16) | ((UINT)src[in + 3] << 24);
+            in += 4;
+            flag_count = 32;
+        }
+        flag_count--;
+
+        if (in == src_size) break;
+        if (!(flags & (1u << flag_count)))
+        {
+            if (out == dst_size) return ERROR_INSUFFICIENT_BUFFER;
+            dst[out++] = src[in++];
+            continue;
+        }
+
+        if (src_size - in < 2) return ERROR_BAD_COMPRESSION_BUFFER;
+        len = src[in] | (src[in + 1] << 8);
+        in += 2;
+        offset = (len >> 3) + 1;
+        len &= 7;
+        if (len == 7)
+        {
+            if (!half_byte_pos)
+            {
+                if (in == src_size) return ERROR_BAD_COMPRESSION_BUFFER;
+                half_byte_pos = in;
+                len = src[in++] & 15;
+            }
+            else
+            {
+                len = src[half_byte_pos] >> 4;
+                half_byte_pos = 0;
+            }
+            if (len == 15)
+            {
+                if (in == src_size) return ERROR_BAD_COMPRESSION_BUFFER;
+                len = src[in++];
+                if (len == 255)
+                {
+                    if (src_size - in < 2) return ERROR_BAD_COMPRESSION_BUFFER;
+                    len = src[in] | (src[in + 1] << 8);
+                    in += 2;
+                    if (!len)
+                    {
+                        if (src_size - in < 4) return ERROR_BAD_COMPRESSION_BUFFER;
+                        len = src[in] | (src[in + 1] << 8) | (src[in + 2] << 16) | ((UINT)src[in + 3] << 24);
+                        in += 4;
+                    }
+                    if (len < 15 + 7) return ERROR_BAD_COMPRESSION_BUFFER;
+                    len -= 15 + 7;
+                }
+                len += 15;
+            }
+            len += 7;
+        }
+        len += 3;
+
+        if (offset > out) return ERROR_BAD_COMPRESSION_BUFFER;
+        if (dst_size - out < len) return ERROR_INSUFFICIENT_BUFFER;
+        /* the source may overlap the destination, copy forwards byte by byte */
+        for (; len; len--, out++) dst[out] = dst[out - offset];
+    }
+
+    *ret_size = out;
+    return ERROR_SUCCESS;
+}
+
 /***********************************************************************
  *		CreateCompressor (CABINET.30)
  */
 BOOL WINAPI CreateCompressor( DWORD algorithm, COMPRESS_ALLOCATION_ROUTINES *routines, COMPRESSOR_HANDLE *handle )
 {
-    FIXME("algo (%lu) stub\n", algorithm);
+    COMPRESS_ALLOCATION_ROUTINES default_routines = { 0 };
+    struct compressor *compressor;
+
+    TRACE( "%#lx, %p, %p\n", algorithm, routines, handle );
+
+    if (!handle || !is_valid_algorithm( algorithm ))
+    {
+        SetLastError( ERROR_INVALID_PARAMETER );
+        return FALSE;
+    }
+    if (!routines) routines = &default_routines;
+
+    if (!(compressor = compress_alloc( routines, sizeof(*compressor) )))
+    {
+        SetLastError( ERROR_NOT_ENOUGH_MEMORY );
+        return FALSE;
+    }
+    compressor->algorithm = algorithm & ~COMPRESS_RAW;
+    compressor->raw       = !!(algorithm & COMPRESS_RAW);
+    compressor->routines  = *routines;
+    compressor->hash      = NULL;
+
+    if (compressor->algorithm == COMPRESS_ALGORITHM_XPRESS && compressor->raw &&
+        !(compressor->hash = compress_alloc( routines, sizeof(*compressor->hash) << XPRESS_HASH_BITS )))
+    {
+        compress_free( routines, compressor );
+        SetLastError( ERROR_NOT_ENOUGH_MEMORY );
+        return FALSE;
+    }
+
+    *handle = (COMPRESSOR_HANDLE)compressor;
     return TRUE;
 }
 
@@ -38,7 +297,30 @@ BOOL WINAPI CreateCompressor( DWORD algorithm, COMPRESS_ALLOCATION_ROUTINES *rou
 BOOL WINAPI Compress( COMPRESSOR_HANDLE handle, const VOID *data, SIZE_T data_size,
                       VOID *buffer, SIZE_T buffer_size, SIZE_T *compressed_data_size )
 {
-    FIXME("stub\n");
+    struct compressor *compressor = (struct compressor *)handle;
+    DWORD err;
+
+    TRACE( "%p, %p, %Iu, %p, %Iu, %p\n", handle, data, data_size, buffer, buffer_size, compressed_data_size );
+
+    if (!compressor || !compressed_data_size)
+    {
+        SetLastError( ERROR_INVALID_PARAMETER );
+        return FALSE;
+    }
+
+    if (compressor->algorithm == COMPRESS_ALGORITHM_XPRESS && compressor->raw)
+    {
+        if (!buffer) buffer_size = 0;
+        if ((err = xpress_compress( compressor, data, data_size, buffer, buffer_size, compressed_data_size )))
+        {
+            if (err == ERROR_INSUFFICIENT_BUFFER) *compressed_data_size = xpress_bound( data_size );
+            SetLastError( err );
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    FIXME( "algorithm %lu, raw %d stub\n", compressor->algorithm, compressor->raw );
 
     *compressed_data_size = data_size;
 
@@ -56,7 +338,17 @@ BOOL WINAPI Compress( COMPRESSOR_HANDLE handle, const VOID *data, SIZE_T data_si
  */
 BOOL WINAPI CloseCompressor( COMPRESSOR_HANDLE handle )
 {
-    FIXME("stub\n");
+    struct compressor *compressor = (struct compressor *)handle;
+
+    TRACE( "%p\n", handle );
+
+    if (!compressor)
+    {
+        SetLastError( ERROR_INVALID_HANDLE );
+        return FALSE;
+    }
+    if (compressor->hash) compress_free( &compressor->routines, compressor->hash );
+    compress_free( &compressor->routines, compressor );
     return TRUE;
 }
 
@@ -65,7 +357,28 @@ BOOL WINAPI CloseCompressor( COMPRESSOR_HANDLE handle )
  */
 BOOL WINAPI CreateDecompressor( DWORD algorithm, COMPRESS_ALLOCATION_ROUTINES *routines, DECOMPRESSOR_HANDLE *handle )
 {
-    FIXME("algo (%lu) stub\n", algorithm);
+    COMPRESS_ALLOCATION_ROUTINES default_routines = { 0 };
+    struct decompressor *decompressor;
+
+    TRACE( "%#lx, %p, %p\n", algorithm, routines, handle );
+
+    if (!handle || !is_valid_algorithm( algorithm ))
+    {
+        SetLastError( ERROR_INVALID_PARAMETER );
+        return FALSE;
+    }
+    if (!routines) routines = &default_routines;
+
+    if (!(decompressor = compress_alloc( routines, sizeof(*decompressor) )))
+    {
+        SetLastError( ERROR_NOT_ENOUGH_MEMORY );
+        return FALSE;
+    }
+    decompressor->algorithm = algorithm & ~COMPRESS_RAW;
+    decompressor->raw       = !!(algorithm & COMPRESS_RAW);
+    decompressor->routines  = *routines;
+
+    *handle = (DECOMPRESSOR_HANDLE)decompressor;
     return TRUE;
 }
 
@@ -75,7 +388,32 @@ BOOL WINAPI CreateDecompressor( DWORD algorithm, COMPRESS_ALLOCATION_ROUTINES *r
 BOOL WINAPI Decompress( DECOMPRESSOR_HANDLE handle, const VOID *data, SIZE_T data_size,
                         VOID *buffer, SIZE_T buffer_size, SIZE_T *decompressed_data_size)
 {
-    FIXME("stub\n");
+    struct decompressor *decompressor = (struct decompressor *)handle;
+    SIZE_T size = 0;
+    DWORD err;
+
+    TRACE( "%p, %p, %Iu, %p, %Iu, %p\n", handle, data, data_size, buffer, buffer_size, decompressed_data_size );
+
+    if (!decompressor)
+    {
+        SetLastError( ERROR_INVALID_PARAMETER );
+        return FALSE;
+    }
+
+    if (decompressor->algorithm == COMPRESS_ALGORITHM_XPRESS && decompressor->raw)
+    {
+        if (!buffer) buffer_size = 0;
+        err = xpress_decompress( data, data_size, buffer, buffer_size, &size );
+        if (decompressed_data_size) *decompressed_data_size = size;
+        if (err)
+        {
+            SetLastError( err );
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    FIXME( "algorithm %lu, raw %d stub\n", decompressor->algorithm, decompressor->raw );
 
     *decompressed_data_size = data_size;
 
@@ -93,6 +431,15 @@ BOOL WINAPI Decompress( DECOMPRESSOR_HANDLE handle, const VOID *data, SIZE_T dat
  */
 BOOL WINAPI CloseDecompressor( DECOMPRESSOR_HANDLE handle )
 {
-    FIXME("stub\n");
+    struct decompressor *decompressor = (struct decompressor *)handle;
+
+    TRACE( "%p\n", handle );
+
+    if (!decompressor)
+    {
+        SetLastError( ERROR_INVALID_HANDLE );
+        return FALSE;
+    }
+    compress_free( &decompressor->routines, decompressor );
     return TRUE;
 }
@@ -0,0 +1,114 @@
+/*
+ * Unit tests for the Compression API
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include <windows.h>
+#include "compressapi.h"
+#include "wine/test.h"
+
+/* examples from [MS-XCA] 3.1 */
+static const BYTE xpress_alphabet[] =
+{
+    0x3f, 0x00, 0x00, 0x00, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'
+};
+static const BYTE xpress_abc[] =
+{
+    0xff, 0xff, 0xff, 0x1f, 'a', 'b', 'c', 0x17, 0x00, 0x0f, 0xff, 0x26, 0x01
+};
+
+static void test_handles(void)
+{
+    COMPRESSOR_HANDLE compressor;
+    DECOMPRESSOR_HANDLE decompressor;
+    BOOL ret;
+
+    SetLastError( 0xdeadbeef );
+    ret = CreateCompressor( COMPRESS_ALGORITHM_INVALID, NULL, &compressor );
+    ok( !ret, "CreateCompressor succeeded\n" );
+    ok( GetLastError() == ERROR_INVALID_PARAMETER, "got %lu\n", GetLastError() );
+
+    SetLastError( 0xdeadbeef );
+    ret = CreateDecompressor( COMPRESS_ALGORITHM_MAX, NULL, &decompressor );
+    ok( !ret, "CreateDecompressor succeeded\n" );
+    ok( GetLastError() == ERROR_INVALID_PARAMETER, "got %lu\n", GetLastError() );
+
+    ret = CreateCompressor( COMPRESS_ALGORITHM_XPRESS, NULL, &compressor );
+    ok( ret, "CreateCompressor failed %lu\n", GetLastError() );
+    ret = CloseCompressor( compressor );
+    ok( ret, "CloseCompressor failed %lu\n", GetLastError() );
+
+    ret = CreateDecompressor( COMPRESS_ALGORITHM_XPRESS, NULL, &decompressor );
+    ok( ret, "CreateDecompressor failed %lu\n", GetLastError() );
+    ret = CloseDecompressor( decompressor );
+    ok( ret, "CloseDecompressor failed %lu\n", GetLastError() );
+}
+
+static void test_xpress_raw(void)
+{
+    COMPRESSOR_HANDLE compressor;
+    DECOMPRESSOR_HANDLE decompressor;
+    BYTE data[4096], compressed[4096 + 1024], buffer[4096];
+    SIZE_T size;
+    unsigned int i;
+    BOOL ret;
+
+    ret = CreateDecompressor( COMPRESS_ALGORITHM_XPRESS | COMPRESS_RAW, NULL, &decompressor );
+    ok( ret, "CreateDecompressor failed %lu\n", GetLastError() );
+
+    size = 0;
+    ret = Decompress( decompressor, xpress_alphabet, sizeof(xpress_alphabet), buffer, 26, &size );
+    ok( ret, "Decompress failed %lu\n", GetLastError() );
+    ok( size == 26, "got size %Iu\n", size );
+    ok( !memcmp( buffer, "abcdefghijklmnopqrstuvwxyz", 26 ), "wrong data\n" );
+
+    size = 0;
+    ret = Decompress( decompressor, xpress_abc, sizeof(xpress_abc), buffer, 300, &size );
+    ok( ret, "Decompress failed %lu\n", GetLastError() );
+    ok( size == 300, "got size %Iu\n", size );
+    for (i = 0; i < 300; i++) if (buffer[i] != "abc"[i % 3]) break;
+    ok( i == 300, "wrong data at %u\n", i );
+
+    ret = CreateCompressor( COMPRESS_ALGORITHM_XPRESS | COMPRESS_RAW, NULL, &compressor );
+    ok( ret, "CreateCompressor failed %lu\n", GetLastError() );
+
+    for (i = 0; i < sizeof(data); i++) data[i] = (i * 7 / 13) ^ (i >> 5);
+    size = 0;
+    ret = Compress( compressor, data, sizeof(data), compressed, sizeof(compressed), &size );
+    ok( ret, "Compress failed %lu\n", GetLastError() );
+    ok( size && size < sizeof(data), "got size %Iu\n", size );
+
+    memset( buffer, 0, sizeof(buffer) );
+    ret = Decompress( decompressor, compressed, size, buffer, sizeof(buffer), &size );
+    ok( ret, "Decompress failed %lu\n", GetLastError() );
+    ok( size == sizeof(data), "got size %Iu\n", size );
+    ok( !memcmp( buffer, data, sizeof(data) ), "wrong data\n" );
+
+    SetLastError( 0xdeadbeef );
+    ret = Compress( compressor, data, sizeof(data), compressed, 16, &size );
+    ok( !ret, "Compress succeeded\n" );
+    ok( GetLastError() == ERROR_INSUFFICIENT_BUFFER, "got %lu\n", GetLastError() );
+
+    CloseCompressor( compressor );
+    CloseDecompressor( decompressor );
+}
+
+START_TEST(compress)
+{
+    test_handles();
+    test_xpress_raw();
+}
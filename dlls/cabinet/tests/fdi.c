@@ -114,6 +114,48 @@ static const struct
     { 'H','e','l','l','o',' ','W','o','r','l','d','!' }
 };
 
+/* an LZX folder followed by an MSZIP folder, both storing "Hello World!" */
+static const struct cab_folders
+{
+    struct CFHEADER header;
+    struct CFFOLDER folder[2];
+    struct CFFILE file1;
+    UCHAR szName1[sizeof("lzx.dat")];
+    struct CFFILE file2;
+    UCHAR szName2[sizeof("zip.dat")];
+    struct CFDATA data1;
+    UCHAR ab1[28];
+    struct CFDATA data2;
+    UCHAR ab2[19];
+} cab_folders_data =
+{
+    { {'M','S','C','F'}, 0, sizeof(struct cab_folders), 0, sizeof(struct CFHEADER) + 2 * sizeof(struct CFFOLDER), 0, 3,1, 2, 2, 0, 0, 0 },
+    {
+        { sizeof(struct CFHEADER) + 2 * sizeof(struct CFFOLDER) + 2 * (sizeof(struct CFFILE) + sizeof("lzx.dat")), 1, TCOMPfromLZXWindow(15) },
+        { sizeof(struct CFHEADER) + 2 * sizeof(struct CFFOLDER) + 2 * (sizeof(struct CFFILE) + sizeof("lzx.dat"))
+          + sizeof(struct CFDATA) + 28, 1, tcompTYPE_MSZIP },
+    },
+    { sizeof("Hello World!")-1, 0, 0, 0x1225, 0x2013, 0 },
+    { 'l','z','x','.','d','a','t',0 },
+    { sizeof("Hello World!")-1, 0, 1, 0x1225, 0x2013, 0 },
+    { 'z','i','p','.','d','a','t',0 },
+    { 0, 28, sizeof("Hello World!")-1 },
+    {
+        /* no E8 translation, uncompressed block of 12 bytes, padding */
+        0x00, 0x30, 0xc0, 0x00,
+        /* R0, R1, R2 */
+        1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0,
+        'H','e','l','l','o',' ','W','o','r','l','d','!'
+    },
+    { 0, 19, sizeof("Hello World!")-1 },
+    {
+        'C','K',
+        /* final stored deflate block of 12 bytes */
+        0x01, 0x0c, 0x00, 0xf3, 0xff,
+        'H','e','l','l','o',' ','W','o','r','l','d','!'
+    }
+};
+
 #pragma pack(pop)
 
 struct mem_data
@@ -736,16 +778,25 @@ static INT_PTR CDECL fdi_mem_open(char *name, int oflag, int pmode)
 {
     static const char expected[] = "memory\\block";
     struct mem_data *data;
+    BOOL folders = !strcmp(name, "memory\\folders");
 
-    ok(!strcmp(name, expected), "expected %s, got %s\n", expected, name);
+    ok(folders || !strcmp(name, expected), "expected %s, got %s\n", expected, name);
     ok(oflag == _O_BINARY, "expected _O_BINARY, got %x\n", oflag);
     ok(pmode == (_S_IREAD | _S_IWRITE), "expected _S_IREAD | _S_IWRITE, got %x\n", pmode);
 
     data = HeapAlloc(GetProcessHeap(), 0, sizeof(*data));
     if (!data) return -1;
 
-    data->base = (const char *)&cab_data;
-    data->size = sizeof(cab_data);
+    if (folders)
+    {
+        data->base = (const char *)&cab_folders_data;
+        data->size = sizeof(cab_folders_data);
+    }
+    else
+    {
+        data->base = (const char *)&cab_data;
+        data->size = sizeof(cab_data);
+    }
     data->pos = 0;
 
     trace("mem_open(%s,%x,%x) => %p\n", name, oflag, pmode, data);
@@ -847,6 +898,29 @@ static INT_PTR CDECL fdi_mem_notify(FDINOTIFICATIONTYPE fdint, FDINOTIFICATION *
     return 0;
 }
 
+static INT_PTR CDECL fdi_mem_folders_notify(FDINOTIFICATIONTYPE fdint, FDINOTIFICATION *info)
+{
+    static const char *expected[] = { "lzx.dat", "zip.dat" };
+    int *count = info->pv;
+
+    switch (fdint)
+    {
+    case fdintCLOSE_FILE_INFO:
+        ok(*count < ARRAY_SIZE(expected), "unexpected file %s\n", info->psz1);
+        if (*count < ARRAY_SIZE(expected))
+            ok(!strcmp(info->psz1, expected[*count]), "expected %s, got %s\n", expected[*count], info->psz1);
+        (*count)++;
+        return 1;
+
+    case fdintCOPY_FILE:
+        ok(info->cb == 12, "expected 12, got %lu\n", info->cb);
+        return 0x12345678; /* call write() callback */
+
+    default:
+        return 0;
+    }
+}
+
 static void test_FDICopy(void)
 {
     CCAB cabParams;
@@ -859,8 +933,10 @@ static void test_FDICopy(void)
     char memory_block[] = "memory\\block";
     char memory[] = "memory\\";
     char block[] = "block";
+    char folders[] = "folders";
     FDICABINETINFO info;
     INT_PTR fd;
+    int count;
 
     set_cab_parameters(&cabParams);
 
@@ -931,6 +1007,12 @@ static void test_FDICopy(void)
     ret = FDICopy(hfdi, block, memory, 0, fdi_mem_notify, NULL, 0);
     ok(ret, "FDICopy error %d\n", erf.erfOper);
 
+    /* switching from an LZX folder to an MSZIP folder */
+    count = 0;
+    ret = FDICopy(hfdi, folders, memory, 0, fdi_mem_folders_notify, NULL, &count);
+    ok(ret, "FDICopy error %d\n", erf.erfOper);
+    ok(count == 2, "expected 2 files, got %d\n", count);
+
     FDIDestroy(hfdi);
 }
 
@@ -449,7 +449,8 @@ static HRESULT compile_member_expression(compiler_ctx_t *ctx, member_expression_
     if(FAILED(hres))
         return hres;
 
-    return push_instr_bstr(ctx, OP_member, expr->identifier);
+    /* the second argument caches the id found by the previous lookup */
+    return push_instr_bstr_uint(ctx, OP_member, expr->identifier, 0);
 }
 
 #define LABEL_FLAG 0x80000000
@@ -170,8 +170,16 @@ found:
 static inline unsigned string_hash(const WCHAR *name)
 {
     unsigned h = 0;
-    for(; *name; name++)
-        h = (h>>(sizeof(unsigned)*8-4)) ^ (h<<4) ^ towlower(*name);
+    WCHAR c;
+
+    for(; *name; name++) {
+        c = *name;
+        if(c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        else if(c >= 0x80)
+            c = towlower(c);
+        h = (h>>(sizeof(unsigned)*8-4)) ^ (h<<4) ^ c;
+    }
     return h;
 }
 
@@ -2593,6 +2601,29 @@ HRESULT jsdisp_get_id(jsdisp_t *jsdisp, const WCHAR *name, DWORD flags, DISPID *
     return DISP_E_UNKNOWNNAME;
 }
 
+/* Like jsdisp_get_id, but first tries the id stored in *hint, usually the
+ * result of an earlier lookup of the same name, before searching by name. */
+HRESULT jsdisp_get_id_hint(jsdisp_t *jsdisp, const WCHAR *name, unsigned *hint, DISPID *id)
+{
+    dispex_prop_t *prop;
+    DWORD idx = *hint - 1;
+    HRESULT hres;
+
+    if(idx < jsdisp->prop_cnt) {
+        prop = &jsdisp->props[idx];
+        if(prop->type != PROP_DELETED && prop->type != PROP_PROTREF && prop->type != PROP_EXTERN
+           && !wcscmp(prop->name, name)) {
+            *id = *hint;
+            return S_OK;
+        }
+    }
+
+    hres = jsdisp_get_id(jsdisp, name, 0, id);
+    if(SUCCEEDED(hres))
+        *hint = *id;
+    return hres;
+}
+
 HRESULT jsdisp_get_idx_id(jsdisp_t *jsdisp, DWORD idx, DISPID *id)
 {
     WCHAR name[11];
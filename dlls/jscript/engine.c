@@ -1443,7 +1443,9 @@ static HRESULT interp_array(script_ctx_t *ctx)
 /* ECMA-262 3rd Edition    11.2.1 */
 static HRESULT interp_member(script_ctx_t *ctx)
 {
+    call_frame_t *frame = ctx->call_ctx;
     const BSTR arg = get_op_bstr(ctx, 0);
+    jsdisp_t *jsdisp;
     IDispatch *obj;
     jsval_t v;
     DISPID id;
@@ -1455,7 +1457,10 @@ static HRESULT interp_member(script_ctx_t *ctx)
     if(FAILED(hres))
         return hres;
 
-    hres = disp_get_id(ctx, obj, arg, arg, 0, &id);
+    if((jsdisp = to_jsdisp(obj)))
+        hres = jsdisp_get_id_hint(jsdisp, arg, &frame->bytecode->instrs[frame->ip].u.arg[1].uint, &id);
+    else
+        hres = disp_get_id(ctx, obj, arg, arg, 0, &id);
     if(SUCCEEDED(hres)) {
         hres = disp_propget(ctx, obj, id, &v);
     }else if(hres == DISP_E_UNKNOWNNAME) {
@@ -265,6 +265,7 @@ HRESULT jsdisp_propput_idx(jsdisp_t*,DWORD,jsval_t);
 HRESULT jsdisp_propget_name(jsdisp_t*,LPCWSTR,jsval_t*);
 HRESULT jsdisp_get_idx(jsdisp_t*,DWORD,jsval_t*);
 HRESULT jsdisp_get_id(jsdisp_t*,const WCHAR*,DWORD,DISPID*);
+HRESULT jsdisp_get_id_hint(jsdisp_t*,const WCHAR*,unsigned*,DISPID*);
 HRESULT jsdisp_get_idx_id(jsdisp_t*,DWORD,DISPID*);
 HRESULT disp_delete(IDispatch*,DISPID,BOOL*);
 HRESULT disp_delete_name(script_ctx_t*,IDispatch*,jsstr_t*,BOOL*);
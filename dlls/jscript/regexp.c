@@ -2529,6 +2529,31 @@ SimpleMatch(REGlobalData *gData, match_state_t *x, REOp op,
     return NULL;
 }
 
+/*
+ * Get the character a case sensitive literal must start with, so that the
+ * input can be searched for it directly.
+ */
+static BOOL
+GetLiteralFirstChar(regexp_t *re, REOp op, jsbytecode *pc, WCHAR *ch)
+{
+    size_t offset;
+
+    switch (op) {
+      case REOP_FLAT:
+        ReadCompactIndex(pc, &offset);
+        *ch = re->source[offset];
+        return TRUE;
+      case REOP_FLAT1:
+        *ch = *pc;
+        return TRUE;
+      case REOP_UCFLAT1:
+        *ch = GET_ARG(pc);
+        return TRUE;
+      default:
+        return FALSE;
+    }
+}
+
 static inline match_state_t *
 ExecuteREBytecode(REGlobalData *gData, match_state_t *x)
 {
@@ -2554,8 +2579,20 @@ ExecuteREBytecode(REGlobalData *gData, match_state_t *x)
      * until that match is made, or fail if it can't be found at all.
      */
     if (REOP_IS_SIMPLE(op) && !(gData->regexp->flags & REG_STICKY)) {
+        BOOL literal = GetLiteralFirstChar(gData->regexp, op, pc, &matchCh1);
+
         anchor = FALSE;
         while (x->cp <= gData->cpend) {
+            if (literal) {
+                /* no match is possible before the next occurrence of the first character */
+                startcp = wmemchr(x->cp, matchCh1, gData->cpend - x->cp);
+                if (!startcp) {
+                    gData->skipped += gData->cpend - x->cp + 1;
+                    goto bad;
+                }
+                gData->skipped += startcp - x->cp;
+                x->cp = startcp;
+            }
             nextpc = pc;    /* reset back to start each time */
             result = SimpleMatch(gData, x, op, &nextpc, TRUE);
             if (result) {
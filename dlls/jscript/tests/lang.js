@@ -2009,6 +2009,34 @@ ok(tmp.hasOwnProperty("x"), "tmp does not have 'x' property");
 ok(!tmp.hasOwnProperty("y"), "tmp has 'y' property");
 ok(tmp.toString() == "[object Object]", "tmp.toString returned " + tmp.toString());
 
+function testMemberSite() {
+    function get_x(o) { return o.x; }
+    var objs = [{x: 1, y: 2}, {y: 3, x: 4}, {X: 5}, {x: 6}], protoObj, i;
+    var expected = [1, 4, undefined, 6];
+
+    for(i = 0; i < objs.length; i++) {
+        ok(get_x(objs[i]) === expected[i], "get_x(objs[" + i + "]) = " + get_x(objs[i]));
+        ok(get_x(objs[i]) === expected[i], "second get_x(objs[" + i + "]) = " + get_x(objs[i]));
+    }
+
+    delete objs[0].x;
+    ok(get_x(objs[0]) === undefined, "get_x(objs[0]) after delete = " + get_x(objs[0]));
+    objs[0].x = 7;
+    ok(get_x(objs[0]) === 7, "get_x(objs[0]) after set = " + get_x(objs[0]));
+
+    function P() {}
+    P.prototype.x = 8;
+    protoObj = new P();
+    ok(get_x(protoObj) === 8, "get_x(protoObj) = " + get_x(protoObj));
+    P.prototype.x = 9;
+    ok(get_x(protoObj) === 9, "get_x(protoObj) after prototype change = " + get_x(protoObj));
+    protoObj.x = 10;
+    ok(get_x(protoObj) === 10, "get_x(protoObj) with own x = " + get_x(protoObj));
+    ok(get_x(objs[3]) === 6, "get_x(objs[3]) = " + get_x(objs[3]));
+    ok(get_x("test") === undefined, "get_x(\"test\") = " + get_x("test"));
+}
+testMemberSite();
+
 function do_test() {}
 function nosemicolon() {} nosemicolon();
 function () {} nosemicolon();
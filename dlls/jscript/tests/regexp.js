@@ -768,4 +768,15 @@ ok(re.ignoreCase === false, "re.ignoreCase = " + re.ignoreCase);
 ok(re.multiline === true, "re.multiline = " + re.multiline);
 ok(re.global === true, "re.global = " + re.global);
 
+m = "aabaabaaab".match(/aaab/);
+ok(m.index === 6, "m.index = " + m.index);
+ok(m[0] === "aaab", "m[0] = " + m[0]);
+ok(RegExp.leftContext === "aabaab", "RegExp.leftContext = " + RegExp.leftContext);
+ok("xxxxxxxx".search(/y/) === -1, "search(/y/) = " + "xxxxxxxx".search(/y/));
+ok("xxxxxxxy".search(/y/) === 7, "search(/y/) = " + "xxxxxxxy".search(/y/));
+ok("xxxxxxxx".search(/xy/) === -1, "search(/xy/) = " + "xxxxxxxx".search(/xy/));
+ok("\u0100x\u0101".search(/\u0101/) === 2, "search(/\\u0101/) = " + "\u0100x\u0101".search(/\u0101/));
+ok("a,b,,c".split(/,/).length === 4, "split length = " + "a,b,,c".split(/,/).length);
+ok("abcabc".replace(/c/g, "-") === "ab-ab-", "replace = " + "abcabc".replace(/c/g, "-"));
+
 reportSuccess();
@@ -2124,6 +2124,18 @@ static void test_CompareStringW(void)
     ok(ret == CSTR_LESS_THAN, "expected CSTR_LESS_THAN, got %d\n", ret);
     ret = CompareStringW(LOCALE_USER_DEFAULT, NORM_IGNORENONSPACE, A_NULL_BC, 4, A_ACUTE_BC_DECOMP, 5);
     ok(ret == CSTR_EQUAL, "expected CSTR_EQUAL, got %d\n", ret);
+
+    /* strings with a common prefix */
+    ret = CompareStringW(LOCALE_USER_DEFAULT, 0, L"abcd", -1, L"abce", -1);
+    ok(ret == CSTR_LESS_THAN, "expected CSTR_LESS_THAN, got %d\n", ret);
+    ret = CompareStringW(LOCALE_USER_DEFAULT, 0, L"abcD", -1, L"abcd", -1);
+    ok(ret == CSTR_GREATER_THAN, "expected CSTR_GREATER_THAN, got %d\n", ret);
+    ret = CompareStringW(LOCALE_USER_DEFAULT, 0, L"abc\x0301", -1, L"abc", -1);
+    ok(ret == CSTR_GREATER_THAN, "expected CSTR_GREATER_THAN, got %d\n", ret);
+    ret = CompareStringW(LOCALE_USER_DEFAULT, 0, L"abc\x00e9", -1, L"abcE", -1);
+    ok(ret == CSTR_GREATER_THAN, "expected CSTR_GREATER_THAN, got %d\n", ret);
+    ret = CompareStringW(LOCALE_USER_DEFAULT, NORM_IGNORECASE, L"abcdef", -1, L"ABCDEF", -1);
+    ok(ret == CSTR_EQUAL, "expected CSTR_EQUAL, got %d\n", ret);
 }
 
 struct comparestringex_test {
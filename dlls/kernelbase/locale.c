@@ -3825,6 +3825,27 @@ static int get_sortkey( const struct sortguid *sortid, DWORD flags,
 }
 
 
+/* length of the common prefix made of plain ASCII characters that can be skipped during comparison */
+static int get_common_prefix_len( const struct sortguid *sortid, DWORD flags, UINT except,
+                                  const WCHAR *src1, int srclen1, const WCHAR *src2, int srclen2 )
+{
+    union char_weights weights;
+    int pos, len = min( srclen1, srclen2 );
+
+    /* reversed diacritics would move the prefix weights to the end of the key */
+    if (sortid->flags & FLAG_REVERSEDIACRITICS) return 0;
+
+    for (pos = 0; pos < len; pos++)
+    {
+        if (src1[pos] != src2[pos] || src1[pos] >= 0x80) break;
+        weights = get_char_weights( src1[pos], except );
+        if (weights._case & CASE_COMPR_6) break;
+        if (weights.script < SCRIPT_DIGIT || weights.script > SCRIPT_ARABIC) break;
+        if (weights.script == SCRIPT_DIGIT && (flags & SORT_DIGITSASNUMBERS)) break;
+    }
+    return pos;
+}
+
 /* implementation of CompareStringEx */
 static int compare_string( const struct sortguid *sortid, DWORD flags,
                            const WCHAR *src1, int srclen1, const WCHAR *src2, int srclen2 )
@@ -3845,9 +3866,19 @@ static int compare_string( const struct sortguid *sortid, DWORD flags,
     if (flags & NORM_IGNOREKANATYPE) case_mask &= ~CASE_KATAKANA;
     if ((flags & NORM_LINGUISTIC_CASING) && except && sortid->ling_except) except = sortid->ling_except;
 
+    len = get_common_prefix_len( sortid, flags, except, src1, srclen1, src2, srclen2 );
+    if (len == srclen1 && len == srclen2) return 0;
+    /* keep the last character, a following nonspace mark may still modify its weights */
+    if (len) len--;
+
     init_sortkey_state( &s1, flags, srclen1, primary1, sizeof(primary1) );
     init_sortkey_state( &s2, flags, srclen2, primary2, sizeof(primary2) );
 
+    /* identical plain characters produce identical weights, only their position
+     * matters for the punctuation weights, each of them has two primary bytes */
+    pos1 = pos2 = len;
+    s1.primary_pos = s2.primary_pos = len * 2;
+
     while (pos1 < srclen1 || pos2 < srclen2)
     {
         while (pos1 < srclen1 && !s1.key_primary.len)
@@ -155,6 +155,7 @@ typedef struct {
     HANDLE *shutdown_events;
     CRITICAL_SECTION cs;
     struct list scheduled_chores;
+    TP_WORK *chore_work;
 } ThreadScheduler;
 extern const vtable_ptr ThreadScheduler_vtable;
 
@@ -1413,6 +1414,8 @@ static void ThreadScheduler_dtor(ThreadScheduler *this)
     this->cs.DebugInfo->Spare[0] = 0;
     DeleteCriticalSection(&this->cs);
 
+    if (this->chore_work)
+        CloseThreadpoolWork(this->chore_work);
     if (!list_empty(&this->scheduled_chores))
         ERR("scheduled chore list is not empty\n");
     LIST_FOR_EACH_ENTRY_SAFE(sc, next, &this->scheduled_chores,
@@ -1649,6 +1652,7 @@ static ThreadScheduler* ThreadScheduler_ctor(ThreadScheduler *this,
     this->cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": ThreadScheduler");
 
     list_init(&this->scheduled_chores);
+    this->chore_work = NULL;
     return this;
 }
 
@@ -2310,16 +2314,32 @@ static BOOL pick_and_execute_chore(ThreadScheduler *scheduler)
     return TRUE;
 }
 
-static void __cdecl _StructuredTaskCollection_scheduler_cb(void *data)
+/* Runs queued chores on a thread pool thread. All chores share a single
+ * work object per scheduler, and a worker drains the queue while it is
+ * attached instead of handling a single chore per submission. */
+static void WINAPI chore_work_proc(PTP_CALLBACK_INSTANCE instance, void *context, PTP_WORK work)
 {
-    pick_and_execute_chore((ThreadScheduler*)get_current_scheduler());
+    ThreadScheduler *scheduler = context;
+    BOOL detach = FALSE;
+
+    if(&scheduler->scheduler != get_current_scheduler()) {
+        ThreadScheduler_Attach(scheduler);
+        detach = TRUE;
+    }
+    ThreadScheduler_Release(scheduler);
+
+    while (pick_and_execute_chore(scheduler)) ;
+
+    if(detach)
+        CurrentScheduler_Detach();
 }
 
 static bool schedule_chore(_StructuredTaskCollection *this,
-        _UnrealizedChore *chore, Scheduler **pscheduler)
+        _UnrealizedChore *chore)
 {
     struct scheduled_chore *sc;
     ThreadScheduler *scheduler;
+    TP_WORK *work;
 
     if (chore->task_collection) {
         invalid_multiple_scheduling e;
@@ -2336,6 +2356,18 @@ static bool schedule_chore(_StructuredTaskCollection *this,
         return FALSE;
     }
 
+    EnterCriticalSection(&scheduler->cs);
+    if (!scheduler->chore_work)
+        scheduler->chore_work = CreateThreadpoolWork(chore_work_proc, scheduler, NULL);
+    work = scheduler->chore_work;
+    LeaveCriticalSection(&scheduler->cs);
+    if (!work) {
+        scheduler_resource_allocation_error e;
+        scheduler_resource_allocation_error_ctor_name(&e, NULL,
+                HRESULT_FROM_WIN32(GetLastError()));
+        _CxxThrowException(&e, &scheduler_resource_allocation_error_exception_type);
+    }
+
     sc = operator_new(sizeof(*sc));
     sc->chore = chore;
 
@@ -2346,7 +2378,9 @@ static bool schedule_chore(_StructuredTaskCollection *this,
     EnterCriticalSection(&scheduler->cs);
     list_add_head(&scheduler->scheduled_chores, &sc->entry);
     LeaveCriticalSection(&scheduler->cs);
-    *pscheduler = &scheduler->scheduler;
+
+    ThreadScheduler_Reference(scheduler);
+    SubmitThreadpoolWork(work);
     return TRUE;
 }
 
@@ -2360,15 +2394,9 @@ void __thiscall _StructuredTaskCollection__Schedule_loc(
         _StructuredTaskCollection *this, _UnrealizedChore *chore,
         /*location*/void *placement)
 {
-    Scheduler *scheduler;
-
     TRACE("(%p %p %p)\n", this, chore, placement);
 
-    if (schedule_chore(this, chore, &scheduler))
-    {
-        call_Scheduler_ScheduleTask_loc(scheduler,
-                _StructuredTaskCollection_scheduler_cb, NULL, placement);
-    }
+    schedule_chore(this, chore);
 }
 
 #endif /* _MSVCR_VER >= 110 */
@@ -2380,15 +2408,9 @@ DEFINE_THISCALL_WRAPPER(_StructuredTaskCollection__Schedule, 8)
 void __thiscall _StructuredTaskCollection__Schedule(
         _StructuredTaskCollection *this, _UnrealizedChore *chore)
 {
-    Scheduler *scheduler;
-
     TRACE("(%p %p)\n", this, chore);
 
-    if (schedule_chore(this, chore, &scheduler))
-    {
-        call_Scheduler_ScheduleTask(scheduler,
-                _StructuredTaskCollection_scheduler_cb, NULL);
-    }
+    schedule_chore(this, chore);
 }
 
 static void CALLBACK exception_ptr_rethrow_finally(BOOL normal, void *data)
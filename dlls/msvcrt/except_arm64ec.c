@@ -143,7 +143,7 @@ int handle_fpieee_flt( __msvcrt_ulong exception_code, EXCEPTION_POINTERS *ep,
  */
 void __cdecl __crtCapturePreviousContext( CONTEXT *ctx )
 {
-    UNWIND_HISTORY_TABLE table;
+    UNWIND_HISTORY_TABLE table = {0};
     RUNTIME_FUNCTION *func;
     PEXCEPTION_ROUTINE handler;
     ULONG_PTR pc, frame, base;
@@ -3904,18 +3904,36 @@ int CDECL _fgetchar(void)
  */
 char * CDECL fgets(char *s, int size, FILE* file)
 {
-  int    cc = EOF;
+  int    cc = EOF, cnt;
   char * buf_start = s;
+  char * nl;
 
   TRACE(":file(%p) fd (%d) str (%p) len (%d)\n",
 	file,file->_file,s,size);
 
   _lock_file(file);
 
-  while ((size >1) && (cc = _fgetc_nolock(file)) != EOF && cc != '\n')
+  while (size > 1)
     {
+      if (file->_cnt > 0)
+        {
+          /* copy straight from the stream buffer, up to and including the newline */
+          cnt = min(file->_cnt, size - 1);
+          if ((nl = memchr(file->_ptr, '\n', cnt)))
+            cnt = nl - file->_ptr + 1;
+          memcpy(s, file->_ptr, cnt);
+          file->_ptr += cnt;
+          file->_cnt -= cnt;
+          s += cnt;
+          size -= cnt;
+          cc = (unsigned char)s[-1];
+          if (nl) break;
+          continue;
+        }
+      if ((cc = _filbuf(file)) == EOF) break;
       *s++ = (char)cc;
       size --;
+      if (cc == '\n') break;
     }
   if ((cc == EOF) && (s == buf_start)) /* If nothing read, return 0*/
   {
@@ -3923,8 +3941,6 @@ char * CDECL fgets(char *s, int size, FILE* file)
     _unlock_file(file);
     return NULL;
   }
-  if ((cc != EOF) && (size > 1))
-    *s++ = cc;
   *s = '\0';
   TRACE(":got %s\n", debugstr_a(buf_start));
   _unlock_file(file);
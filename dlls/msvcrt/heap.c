@@ -41,7 +41,7 @@ WINE_DEFAULT_DEBUG_CHANNEL(msvcrt);
 
 #define SB_HEAP_ALIGN 16
 
-static HANDLE heap, sb_heap;
+static HANDLE heap;
 
 typedef int (CDECL *MSVCRT_new_handler_func)(size_t size);
 
@@ -53,50 +53,289 @@ static unsigned int MSVCRT_amblksiz = 16;
 /* FIXME - According to documentation it should be 480 bytes, at runtime default is 0 */
 static size_t MSVCRT_sbh_threshold = 0;
 
-static void* msvcrt_heap_alloc(DWORD flags, size_t size)
+/* Small blocks heap, only available on 32-bit.
+ *
+ * Blocks below the threshold are carved out of 64k regions, each region
+ * holding blocks of a single size class. Freed blocks go to a per-thread
+ * cache and are moved to the shared free lists in batches, so most small
+ * allocations don't need to take any lock. A bitmap of the regions tells
+ * small blocks from regular heap blocks. */
+#define SBH_REGION_SIZE 0x10000
+#define SBH_CLASS_COUNT (1024 / SB_HEAP_ALIGN)
+#define SBH_CACHE_MAX   32
+
+struct sbh_region
+{
+    size_t block_size;
+    char *next;    /* first block that was never handed out */
+};
+
+struct sbh_free_list
+{
+    void *head;
+    unsigned int count;
+};
+
+struct sbh_cache
+{
+    struct sbh_free_list lists[SBH_CLASS_COUNT];
+};
+
+/* stored in the TLS slot once the thread is detaching, so that no new cache gets created */
+#define SBH_CACHE_DETACHED ((struct sbh_cache *)1)
+
+#ifndef _WIN64
+static DWORD sbh_tls_index = TLS_OUT_OF_INDEXES;
+static struct sbh_free_list sbh_lists[SBH_CLASS_COUNT];
+static struct sbh_region *sbh_current[SBH_CLASS_COUNT];
+static LONG sbh_regions[0x100000000ull / SBH_REGION_SIZE / 32];
+/* set at process detach before the locks are freed, the heap lock can't be used after that */
+static BOOL sbh_disabled;
+
+static inline BOOL sbh_is_block(const void *ptr)
+{
+    UINT_PTR region = (UINT_PTR)ptr / SBH_REGION_SIZE;
+    return (ReadNoFence(&sbh_regions[region / 32]) >> (region % 32)) & 1;
+}
+
+static inline size_t sbh_block_size(const void *ptr)
+{
+    return ((struct sbh_region *)((UINT_PTR)ptr & ~(UINT_PTR)(SBH_REGION_SIZE - 1)))->block_size;
+}
+
+/* moves up to count blocks from one list to another */
+static void sbh_move_blocks(struct sbh_free_list *dst, struct sbh_free_list *src, unsigned int count)
 {
-    if(size < MSVCRT_sbh_threshold)
+    void *block;
+
+    while (count-- && (block = src->head))
     {
-        void *memblock, *temp, **saved;
+        src->head = *(void **)block;
+        src->count--;
+        *(void **)block = dst->head;
+        dst->head = block;
+        dst->count++;
+    }
+}
 
-        temp = HeapAlloc(sb_heap, flags, size+sizeof(void*)+SB_HEAP_ALIGN);
-        if(!temp) return NULL;
+/* called with the heap lock held */
+static void *sbh_carve_block(unsigned int cls)
+{
+    struct sbh_region *region = sbh_current[cls];
+    size_t block_size = (cls + 1) * SB_HEAP_ALIGN;
+    UINT_PTR idx;
+    void *block;
 
-        memblock = ALIGN_PTR(temp, SB_HEAP_ALIGN, 0);
-        saved = SAVED_PTR(memblock);
-        *saved = temp;
-        return memblock;
+    if (!region || region->next + block_size > (char *)region + SBH_REGION_SIZE)
+    {
+        if (!(region = VirtualAlloc(NULL, SBH_REGION_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE)))
+            return NULL;
+        region->block_size = block_size;
+        region->next = (char *)region + SB_HEAP_ALIGN;
+        sbh_current[cls] = region;
+
+        idx = (UINT_PTR)region / SBH_REGION_SIZE;
+        InterlockedOr(&sbh_regions[idx / 32], 1u << (idx % 32));
     }
 
+    block = region->next;
+    region->next += block_size;
+    return block;
+}
+
+static struct sbh_cache *sbh_get_cache(BOOL create)
+{
+    DWORD err = GetLastError();  /* need to preserve last error */
+    struct sbh_cache *cache = TlsGetValue(sbh_tls_index);
+
+    if (cache == SBH_CACHE_DETACHED) cache = NULL;
+    else if (!cache && create && (cache = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*cache))))
+    {
+        if (!TlsSetValue(sbh_tls_index, cache))
+        {
+            HeapFree(GetProcessHeap(), 0, cache);
+            cache = NULL;
+        }
+    }
+    SetLastError(err);
+    return cache;
+}
+
+static void *sbh_alloc(DWORD flags, size_t size)
+{
+    unsigned int cls = (size ? size - 1 : 0) / SB_HEAP_ALIGN;
+    struct sbh_cache *cache;
+    struct sbh_free_list *list;
+    void *block = NULL;
+
+    if (sbh_disabled) return NULL;
+
+    if (!(cache = sbh_get_cache(TRUE)))
+    {
+        /* no cache for this thread, use the shared lists directly */
+        LOCK_HEAP;
+        if ((block = sbh_lists[cls].head))
+        {
+            sbh_lists[cls].head = *(void **)block;
+            sbh_lists[cls].count--;
+        }
+        else block = sbh_carve_block(cls);
+        UNLOCK_HEAP;
+        if (!block) return NULL;
+        if (flags & HEAP_ZERO_MEMORY) memset(block, 0, (cls + 1) * SB_HEAP_ALIGN);
+        return block;
+    }
+
+    list = &cache->lists[cls];
+    if (!list->head)
+    {
+        LOCK_HEAP;
+        sbh_move_blocks(list, &sbh_lists[cls], SBH_CACHE_MAX / 2);
+        if (!list->head) block = sbh_carve_block(cls);
+        UNLOCK_HEAP;
+        if (!list->head && !block) return NULL;
+    }
+
+    if (!block)
+    {
+        block = list->head;
+        list->head = *(void **)block;
+        list->count--;
+    }
+
+    if (flags & HEAP_ZERO_MEMORY) memset(block, 0, (cls + 1) * SB_HEAP_ALIGN);
+    return block;
+}
+
+static void sbh_free(void *ptr)
+{
+    unsigned int cls = sbh_block_size(ptr) / SB_HEAP_ALIGN - 1;
+    struct sbh_cache *cache;
+    struct sbh_free_list *list;
+
+    /* the block is simply dropped, sbh_destroy() releases all the regions */
+    if (sbh_disabled) return;
+
+    cache = sbh_get_cache(FALSE);
+    list = cache ? &cache->lists[cls] : NULL;
+    if (!list)
+    {
+        LOCK_HEAP;
+        *(void **)ptr = sbh_lists[cls].head;
+        sbh_lists[cls].head = ptr;
+        sbh_lists[cls].count++;
+        UNLOCK_HEAP;
+        return;
+    }
+
+    *(void **)ptr = list->head;
+    list->head = ptr;
+    if (++list->count > SBH_CACHE_MAX)
+    {
+        LOCK_HEAP;
+        sbh_move_blocks(&sbh_lists[cls], list, SBH_CACHE_MAX / 2);
+        UNLOCK_HEAP;
+    }
+}
+
+void msvcrt_free_sbh_cache(void)
+{
+    struct sbh_cache *cache;
+    unsigned int i;
+
+    if (sbh_tls_index == TLS_OUT_OF_INDEXES || sbh_disabled) return;
+
+    /* blocks allocated or freed later in the thread detach go to the shared lists */
+    cache = sbh_get_cache(FALSE);
+    TlsSetValue(sbh_tls_index, SBH_CACHE_DETACHED);
+    if (!cache) return;
+
+    LOCK_HEAP;
+    for (i = 0; i < SBH_CLASS_COUNT; i++)
+        sbh_move_blocks(&sbh_lists[i], &cache->lists[i], ~0u);
+    UNLOCK_HEAP;
+
+    HeapFree(GetProcessHeap(), 0, cache);
+}
+
+void msvcrt_disable_sbh(void)
+{
+    sbh_disabled = TRUE;
+}
+
+static BOOL sbh_init(void)
+{
+    DWORD index;
+
+    if (sbh_tls_index != TLS_OUT_OF_INDEXES) return TRUE;
+
+    if ((index = TlsAlloc()) == TLS_OUT_OF_INDEXES) return FALSE;
+    if (InterlockedCompareExchange((LONG *)&sbh_tls_index, index, TLS_OUT_OF_INDEXES) != TLS_OUT_OF_INDEXES)
+        TlsFree(index);
+    return TRUE;
+}
+
+static void sbh_destroy(void)
+{
+    unsigned int i, j;
+
+    if (sbh_tls_index == TLS_OUT_OF_INDEXES) return;
+    /* The locks have already been freed at this point, so _lock() can't be used anymore.
+     * The cached blocks don't need to be returned to the shared lists either, since
+     * all the regions are released below. */
+    HeapFree(GetProcessHeap(), 0, sbh_get_cache(FALSE));
+    TlsFree(sbh_tls_index);
+    sbh_tls_index = TLS_OUT_OF_INDEXES;
+
+    for (i = 0; i < ARRAY_SIZE(sbh_regions); i++)
+    {
+        for (j = 0; sbh_regions[i] && j < 32; j++)
+        {
+            if (!(sbh_regions[i] & (1u << j))) continue;
+            VirtualFree((void *)(((UINT_PTR)i * 32 + j) * SBH_REGION_SIZE), 0, MEM_RELEASE);
+        }
+        sbh_regions[i] = 0;
+    }
+}
+#else
+static inline BOOL sbh_is_block(const void *ptr) { return FALSE; }
+static inline size_t sbh_block_size(const void *ptr) { return 0; }
+static inline void *sbh_alloc(DWORD flags, size_t size) { return NULL; }
+static inline void sbh_free(void *ptr) { }
+static inline BOOL sbh_init(void) { return FALSE; }
+static inline void sbh_destroy(void) { }
+void msvcrt_free_sbh_cache(void) { }
+void msvcrt_disable_sbh(void) { }
+#endif
+
+static void* msvcrt_heap_alloc(DWORD flags, size_t size)
+{
+    void *ret;
+
+    /* fall back to the regular heap if no small block is available */
+    if(size < MSVCRT_sbh_threshold && (ret = sbh_alloc(flags, size)))
+        return ret;
+
     return HeapAlloc(heap, flags, size);
 }
 
 static void* msvcrt_heap_realloc(DWORD flags, void *ptr, size_t size)
 {
-    if(sb_heap && ptr && !HeapValidate(heap, 0, ptr))
+    if(ptr && sbh_is_block(ptr))
     {
-        /* TODO: move data to normal heap if it exceeds sbh_threshold limit */
-        void *memblock, *temp, **saved;
-        size_t old_padding, new_padding, old_size;
-
-        saved = SAVED_PTR(ptr);
-        old_padding = (char*)ptr - (char*)*saved;
-        old_size = HeapSize(sb_heap, 0, *saved);
-        if(old_size == -1)
-            return NULL;
-        old_size -= old_padding;
-
-        temp = HeapReAlloc(sb_heap, flags, *saved, size+sizeof(void*)+SB_HEAP_ALIGN);
-        if(!temp) return NULL;
+        size_t old_size = sbh_block_size(ptr);
+        void *memblock;
 
-        memblock = ALIGN_PTR(temp, SB_HEAP_ALIGN, 0);
-        saved = SAVED_PTR(memblock);
-        new_padding = (char*)memblock - (char*)temp;
+        if(size <= old_size)
+            return ptr;
+        if(flags & HEAP_REALLOC_IN_PLACE_ONLY)
+            return NULL;
 
-        if(new_padding != old_padding)
-            memmove(memblock, (char*)temp+old_padding, old_size>size ? size : old_size);
+        memblock = msvcrt_heap_alloc(flags, size);
+        if(!memblock) return NULL;
 
-        *saved = temp;
+        memcpy(memblock, ptr, old_size);
+        sbh_free(ptr);
         return memblock;
     }
 
@@ -105,10 +344,10 @@ static void* msvcrt_heap_realloc(DWORD flags, void *ptr, size_t size)
 
 static BOOL msvcrt_heap_free(void *ptr)
 {
-    if(sb_heap && ptr && !HeapValidate(heap, 0, ptr))
+    if(ptr && sbh_is_block(ptr))
     {
-        void **saved = SAVED_PTR(ptr);
-        return HeapFree(sb_heap, 0, *saved);
+        sbh_free(ptr);
+        return TRUE;
     }
 
     return HeapFree(heap, 0, ptr);
@@ -116,11 +355,8 @@ static BOOL msvcrt_heap_free(void *ptr)
 
 static size_t msvcrt_heap_size(void *ptr)
 {
-    if(sb_heap && ptr && !HeapValidate(heap, 0, ptr))
-    {
-        void **saved = SAVED_PTR(ptr);
-        return HeapSize(sb_heap, 0, *saved);
-    }
+    if(ptr && sbh_is_block(ptr))
+        return sbh_block_size(ptr);
 
     return HeapSize(heap, 0, ptr);
 }
@@ -243,8 +479,7 @@ void* CDECL _expand(void* mem, size_t size)
  */
 int CDECL _heapchk(void)
 {
-  if (!HeapValidate(heap, 0, NULL) ||
-          (sb_heap && !HeapValidate(sb_heap, 0, NULL)))
+  if (!HeapValidate(heap, 0, NULL))
   {
     msvcrt_set_errno(GetLastError());
     return _HEAPBADNODE;
@@ -257,8 +492,7 @@ int CDECL _heapchk(void)
  */
 int CDECL _heapmin(void)
 {
-  if (!HeapCompact( heap, 0 ) ||
-          (sb_heap && !HeapCompact( sb_heap, 0 )))
+  if (!HeapCompact( heap, 0 ))
   {
     if (GetLastError() != ERROR_CALL_NOT_IMPLEMENTED)
       msvcrt_set_errno(GetLastError());
@@ -274,7 +508,7 @@ int CDECL _heapwalk(_HEAPINFO *next)
 {
   PROCESS_HEAP_ENTRY phe;
 
-  if (sb_heap)
+  if (MSVCRT_sbh_threshold)
       FIXME("small blocks heap not supported\n");
 
   LOCK_HEAP;
@@ -528,12 +762,8 @@ int CDECL _set_sbh_threshold(size_t threshold)
   if(threshold > 1016)
      return 0;
 
-  if(!sb_heap)
-  {
-      sb_heap = HeapCreate(0, 0, 0);
-      if(!sb_heap)
-          return 0;
-  }
+  if(!sbh_init())
+      return 0;
 
   MSVCRT_sbh_threshold = (threshold+0xf) & ~0xf;
   return 1;
@@ -842,6 +1072,5 @@ void msvcrt_destroy_heap(void)
 #if _MSVCR_VER <= 100
     HeapDestroy(heap);
 #endif
-    if(sb_heap)
-        HeapDestroy(sb_heap);
+    sbh_destroy();
 }
@@ -146,6 +146,7 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved)
     if (lpvReserved) break;
     msvcrt_free_io();
     msvcrt_free_popen_data();
+    msvcrt_disable_sbh();
     msvcrt_free_locks();
     msvcrt_free_console();
     msvcrt_free_args();
@@ -169,6 +170,7 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved)
 #if _MSVCR_VER >= 100 && _MSVCR_VER <= 120
     msvcrt_free_scheduler_thread();
 #endif
+    msvcrt_free_sbh_cache();
     TRACE("finished thread free\n");
     break;
   }
@@ -272,6 +272,8 @@ extern void msvcrt_free_signals(void);
 extern void msvcrt_free_popen_data(void);
 extern BOOL msvcrt_init_heap(void);
 extern void msvcrt_destroy_heap(void);
+extern void msvcrt_free_sbh_cache(void);
+extern void msvcrt_disable_sbh(void);
 extern void msvcrt_init_clock(void);
 
 #if _MSVCR_VER >= 100
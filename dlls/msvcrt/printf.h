@@ -83,16 +83,18 @@ static inline int FUNC_NAME(pf_fill)(FUNC_NAME(puts_clbk) pf_puts, void *puts_ct
     written = r;
 
     if((!left && flags->LeftAlign) || (left && !flags->LeftAlign)) {
-        APICHAR ch;
+        APICHAR pad[32];
+        int count = flags->FieldLength-len;
 
-        if(left && flags->PadZero)
-            ch = '0';
-        else
-            ch = ' ';
+        /* output the padding in chunks instead of one character at a time */
+        for(i=0; i<count && i<ARRAY_SIZE(pad); i++)
+            pad[i] = left && flags->PadZero ? '0' : ' ';
 
-        for(i=0; i<flags->FieldLength-len && r>=0; i++) {
-            r = pf_puts(puts_ctx, 1, &ch);
+        while(count>0 && r>=0) {
+            i = min(count, ARRAY_SIZE(pad));
+            r = pf_puts(puts_ctx, i, pad);
             written += r;
+            count -= i;
         }
     }
 
@@ -136,6 +138,12 @@ static inline int mbstowcs_len(wchar_t *wcstr, const char *mbstr,
     return wlen;
 }
 
+static const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
 static inline unsigned int log2i(unsigned int x)
 {
     ULONG result;
@@ -570,7 +578,7 @@ static inline void FUNC_NAME(pf_integer_conv)(APICHAR *buf, pf_flags *flags, LON
         digits = "0123456789abcdefx";
 
     if(x<0 && (flags->Format=='d' || flags->Format=='i')) {
-        x = -x;
+        x = -(ULONGLONG)x;
         flags->Sign = '-';
     }
 
@@ -579,11 +587,35 @@ static inline void FUNC_NAME(pf_integer_conv)(APICHAR *buf, pf_flags *flags, LON
         flags->Alternate = FALSE;
         if(flags->Precision)
             buf[i++] = '0';
+    } else if(base == 10) {
+        ULONGLONG v = x;
+        unsigned int w;
+
+        /* digits are generated in reverse order, two at a time */
+        while(v > UINT_MAX) {
+            j = v%100;
+            v /= 100;
+            buf[i++] = digit_pairs[2*j+1];
+            buf[i++] = digit_pairs[2*j];
+        }
+        for(w = v; w >= 100; w /= 100) {
+            j = w%100;
+            buf[i++] = digit_pairs[2*j+1];
+            buf[i++] = digit_pairs[2*j];
+        }
+        if(w >= 10) {
+            buf[i++] = digit_pairs[2*w+1];
+            buf[i++] = digit_pairs[2*w];
+        } else {
+            buf[i++] = '0'+w;
+        }
     } else {
-        while(x != 0) {
-            j = (ULONGLONG)x%base;
-            x = (ULONGLONG)x/base;
-            buf[i++] = digits[j];
+        ULONGLONG v = x;
+        unsigned int shift = base == 16 ? 4 : 3;
+
+        while(v != 0) {
+            buf[i++] = digits[v & (base-1)];
+            v >>= shift;
         }
     }
     k = flags->Precision-i;
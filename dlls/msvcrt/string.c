@@ -33,6 +33,7 @@
 #include "winnls.h"
 #include "wine/asm.h"
 #include "wine/debug.h"
+#include "wine/wordscan.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(msvcrt);
 
@@ -1565,7 +1566,11 @@ int CDECL _atoldbl(_LDOUBLE *value, char *str)
 size_t __cdecl strlen(const char *str)
 {
     const char *s = str;
-    while (*s) s++;
+    const UINT_PTR *w;
+
+    for (; (UINT_PTR)s % sizeof(*w); s++) if (!*s) return s - str;
+    for (w = (const UINT_PTR *)s; !word_has_zero_byte(*w); w++);
+    for (s = (const char *)w; *s; s++);
     return s - str;
 }
 
@@ -1574,10 +1579,17 @@ size_t __cdecl strlen(const char *str)
  */
 size_t CDECL strnlen(const char *s, size_t maxlen)
 {
+    const UINT_PTR *w;
     size_t i;
 
-    for(i=0; i<maxlen; i++)
-        if(!s[i]) break;
+    for (i = 0; i < maxlen && (UINT_PTR)(s + i) % sizeof(*w); i++)
+        if (!s[i]) return i;
+
+    for (w = (const UINT_PTR *)(s + i); maxlen - i >= sizeof(*w); w++, i += sizeof(*w))
+        if (word_has_zero_byte(*w)) break;
+
+    for (; i < maxlen; i++)
+        if (!s[i]) break;
 
     return i;
 }
@@ -3249,6 +3261,18 @@ void *__cdecl memset(void *dst, int c, size_t n)
  */
 char* __cdecl strchr(const char *str, int c)
 {
+    UINT_PTR mask = WORD_ONES_8 * (unsigned char)c;
+    const UINT_PTR *w;
+
+    for (; (UINT_PTR)str % sizeof(*w); str++)
+    {
+        if (*str == (char)c) return (char*)str;
+        if (!*str) return NULL;
+    }
+
+    for (w = (const UINT_PTR *)str; !word_has_zero_byte(*w) && !word_has_zero_byte(*w ^ mask); w++);
+
+    str = (const char *)w;
     do
     {
         if (*str == (char)c) return (char*)str;
@@ -3271,9 +3295,17 @@ char* __cdecl strrchr(const char *str, int c)
  */
 void* __cdecl memchr(const void *ptr, int c, size_t n)
 {
+    UINT_PTR mask = WORD_ONES_8 * (unsigned char)c;
     const unsigned char *p = ptr;
+    const UINT_PTR *w;
+
+    for (; n && (UINT_PTR)p % sizeof(*w); n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+
+    for (w = (const UINT_PTR *)p; n >= sizeof(*w); w++, n -= sizeof(*w))
+        if (word_has_zero_byte(*w ^ mask)) break;
 
-    for (p = ptr; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (p = (const unsigned char *)w; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
     return NULL;
 }
 
@@ -418,7 +418,8 @@ static void test_aligned(void)
 static void test_sbheap(void)
 {
     HMODULE msvcrt = GetModuleHandleA("msvcrt.dll");
-    void *mem;
+    void *mem, *blocks[512];
+    unsigned int i, j;
     int threshold;
 
     p__set_sbh_threshold = (void*)GetProcAddress(msvcrt, "_set_sbh_threshold");
@@ -460,6 +461,28 @@ static void test_sbheap(void)
     ok(mem != NULL, "realloc failed\n");
     ok(!((UINT_PTR)mem & 0xf), "incorrect alignment (%p)\n", mem);
 
+    /* sizes cover all the small block classes and cross the 1008 bytes threshold */
+    for (i = 0; i < ARRAY_SIZE(blocks); i++)
+    {
+        blocks[i] = malloc(i * 3);
+        ok(blocks[i] != NULL, "malloc failed\n");
+        ok(!((UINT_PTR)blocks[i] & 0xf), "incorrect alignment (%p)\n", blocks[i]);
+        ok(_msize(blocks[i]) >= i * 3, "_msize returned %Iu for %u bytes\n", _msize(blocks[i]), i * 3);
+        memset(blocks[i], i, i * 3);
+    }
+    for (i = 0; i < ARRAY_SIZE(blocks); i++)
+    {
+        size_t size = (i & 1) ? i : 2000;
+
+        blocks[i] = realloc(blocks[i], size);
+        ok(blocks[i] != NULL, "realloc failed\n");
+        for (j = 0; j < min(size, i * 3); j++)
+            if (((unsigned char *)blocks[i])[j] != (unsigned char)i) break;
+        ok(j == min(size, i * 3), "block %u: data not preserved\n", i);
+    }
+    for (i = 0; i < ARRAY_SIZE(blocks); i++)
+        free(blocks[i]);
+
     ok(p__set_sbh_threshold(0), "_set_sbh_threshold failed\n");
     threshold = p__get_sbh_threshold();
     ok(threshold == 0, "threshold = %d\n", threshold);
@@ -139,6 +139,14 @@ static void test_sprintf( void )
         { "% 8.5I64d", "   00100", 0, ULONGLONG_ARG, 0, 100 },
         { "% 8.5I64d", "  -00100", 0, ULONGLONG_ARG, 0, -100 },
         { "%.0I64d", "", 0, ULONGLONG_ARG },
+        { "%I64u", "18446744073709551615", 0, ULONGLONG_ARG, 0, -1 },
+        { "%I64d", "-9223372036854775808", 0, ULONGLONG_ARG, 0, (ULONGLONG)1 << 63 },
+        { "%I64u", "4294967296", 0, ULONGLONG_ARG, 0, (ULONGLONG)1 << 32 },
+        { "%u", "4294967295", 0, INT_ARG, -1 },
+        { "%d", "-1000000007", 0, INT_ARG, -1000000007 },
+        { "%40d", "                                     123", 0, INT_ARG, 123 },
+        { "%-40x|", "7b                                      |", 0, INT_ARG, 123 },
+        { "%+040d", "+000000000000000000000000000000000000123", 0, INT_ARG, 123 },
         { "%#+21.18I64x", " 0x00ffffffffffffff9c", 0, ULONGLONG_ARG, 0, -100 },
         { "%#.25I64o", "0001777777777777777777634", 0, ULONGLONG_ARG, 0, -100 },
         { "%#+24.20I64o", " 01777777777777777777634", 0, ULONGLONG_ARG, 0, -100 },
@@ -75,6 +75,7 @@ static int (__cdecl *p_wcsncpy_s)(wchar_t *wcDest, size_t size, const wchar_t *w
 static int (__cdecl *p_wcsncat_s)(wchar_t *dst, size_t elem, const wchar_t *src, size_t count);
 static int (__cdecl *p_wcsupr_s)(wchar_t *str, size_t size);
 static size_t (__cdecl *p_strnlen)(const char *, size_t);
+static size_t (__cdecl *p_wcsnlen)(const wchar_t *, size_t);
 static __int64 (__cdecl *p_strtoi64)(const char *, char **, int);
 static unsigned __int64 (__cdecl *p_strtoui64)(const char *, char **, int);
 static __int64 (__cdecl *p_wcstoi64)(const wchar_t *, wchar_t **, int);
@@ -1905,6 +1906,76 @@ static void test_strnlen(void)
     ok(res == 0, "Returned length = %d\n", (int)res);
 }
 
+static void test_string_scan(void)
+{
+    char *page, *str;
+    wchar_t *wstr;
+    int len, off, n, res;
+    DWORD old_prot;
+
+    /* put the strings right before a guard page so that overreads fault */
+    page = VirtualAlloc(NULL, 0x2000, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    ok(page != NULL, "VirtualAlloc failed\n");
+    VirtualProtect(page + 0x1000, 0x1000, PAGE_NOACCESS, &old_prot);
+
+    for (len = 0; len < 40; len++)
+    {
+        for (off = 0; off < 16; off++)
+        {
+            str = page + 0x1000 - len - 1 - off;
+            memset(str, 'x', len);
+            str[len] = 0;
+            memset(str + len + 1, 'y', off);
+
+            res = strlen(str);
+            ok(res == len, "%d/%d: strlen returned %d\n", len, off, res);
+            ok(strchr(str, 0) == str + len, "%d/%d: wrong strchr result\n", len, off);
+            ok(!strchr(str, 'y'), "%d/%d: strchr found char after terminator\n", len, off);
+            ok(memchr(str, 0, len + 1) == str + len, "%d/%d: wrong memchr result\n", len, off);
+            ok(!memchr(str, 0, len), "%d/%d: memchr found char past the end\n", len, off);
+            if (len)
+            {
+                str[len - 1] = 'z';
+                ok(strchr(str, 'z') == str + len - 1, "%d/%d: wrong strchr result\n", len, off);
+                ok(memchr(str, 'z', len) == str + len - 1, "%d/%d: wrong memchr result\n", len, off);
+                str[len - 1] = 'x';
+            }
+            for (n = 0; p_strnlen && n <= len + 1; n++)
+            {
+                res = p_strnlen(str, n);
+                ok(res == min(n, len), "%d/%d: strnlen(%d) returned %d\n", len, off, n, res);
+            }
+
+            wstr = (wchar_t *)(page + 0x1000) - len - 1 - off;
+            wmemset(wstr, 'x', len);
+            wstr[len] = 0;
+            wmemset(wstr + len + 1, 0x100, off);
+
+            res = wcslen(wstr);
+            ok(res == len, "%d/%d: wcslen returned %d\n", len, off, res);
+            for (n = 0; p_wcsnlen && n <= len + 1; n++)
+            {
+                res = p_wcsnlen(wstr, n);
+                ok(res == min(n, len), "%d/%d: wcsnlen(%d) returned %d\n", len, off, n, res);
+            }
+        }
+    }
+
+    /* wide string that is not WCHAR aligned */
+    wstr = (wchar_t *)(page + 0x1000 - 9 * sizeof(wchar_t) - 1);
+    wmemset(wstr, 0x100, 8);
+    wstr[8] = 0;
+    res = wcslen(wstr);
+    ok(res == 8, "wcslen returned %d\n", res);
+    if (p_wcsnlen)
+    {
+        res = p_wcsnlen(wstr, 20);
+        ok(res == 8, "wcsnlen returned %d\n", res);
+    }
+
+    VirtualFree(page, 0, MEM_RELEASE);
+}
+
 static void test__strtoi64(void)
 {
     static const char no1[] = "31923";
@@ -5054,6 +5125,7 @@ START_TEST(string)
     p_wcsncat_s = (void *)GetProcAddress( hMsvcrt,"wcsncat_s" );
     p_wcsupr_s = (void *)GetProcAddress( hMsvcrt,"_wcsupr_s" );
     p_strnlen = (void *)GetProcAddress( hMsvcrt,"strnlen" );
+    p_wcsnlen = (void *)GetProcAddress( hMsvcrt,"wcsnlen" );
     p_strtoi64 = (void *)GetProcAddress(hMsvcrt, "_strtoi64");
     p_strtoui64 = (void *)GetProcAddress(hMsvcrt, "_strtoui64");
     p_wcstoi64 = (void *)GetProcAddress(hMsvcrt, "_wcstoi64");
@@ -5189,4 +5261,5 @@ START_TEST(string)
     test__tolower_l();
     test__strnicmp_l();
     test_toupper();
+    test_string_scan();
 }
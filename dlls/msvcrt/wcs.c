@@ -31,6 +31,7 @@
 #include "winternl.h"
 #include "wtypes.h"
 #include "wine/debug.h"
+#include "wine/wordscan.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(msvcrt);
 
@@ -2907,9 +2908,18 @@ __msvcrt_ulong __cdecl wcstoul(const wchar_t *s, wchar_t **end, int base)
  */
 size_t CDECL wcsnlen(const wchar_t *s, size_t maxlen)
 {
+    const UINT_PTR *w;
     size_t i;
 
-    for (i = 0; i < maxlen; i++)
+    /* strings that are not WCHAR aligned never reach word alignment */
+    for (i = 0; i < maxlen && (UINT_PTR)(s + i) % sizeof(*w); i++)
+        if (!s[i]) return i;
+
+    for (w = (const UINT_PTR *)(s + i); maxlen - i >= sizeof(*w) / sizeof(*s);
+         w++, i += sizeof(*w) / sizeof(*s))
+        if (word_has_zero_wchar(*w)) break;
+
+    for (; i < maxlen; i++)
         if (!s[i]) break;
     return i;
 }
@@ -2971,7 +2981,12 @@ wchar_t* CDECL wcsrchr(const wchar_t *str, wchar_t ch)
 size_t CDECL wcslen(const wchar_t *str)
 {
     const wchar_t *s = str;
-    while (*s) s++;
+    const UINT_PTR *w;
+
+    /* strings that are not WCHAR aligned never reach word alignment */
+    for (; (UINT_PTR)s % sizeof(*w); s++) if (!*s) return s - str;
+    for (w = (const UINT_PTR *)s; !word_has_zero_wchar(*w); w++);
+    for (s = (const wchar_t *)w; *s; s++);
     return s - str;
 }
 
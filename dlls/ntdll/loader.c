@@ -42,6 +42,7 @@ WINE_DECLARE_DEBUG_CHANNEL(relay);
 WINE_DECLARE_DEBUG_CHANNEL(snoop);
 WINE_DECLARE_DEBUG_CHANNEL(loaddll);
 WINE_DECLARE_DEBUG_CHANNEL(imports);
+WINE_DECLARE_DEBUG_CHANNEL(loadtime);
 
 #ifdef _WIN64
 #define DEFAULT_SECURITY_COOKIE_64  (((ULONGLONG)0x00002b99 << 32) | 0x2ddfa232)
@@ -139,6 +140,10 @@ typedef struct _wine_modref
     struct file_id        id;
     ULONG                 CheckSum;
     BOOL                  system;
+    DWORD                *export_hash;      /* hash table of the exported names, built on demand */
+    DWORD                 export_hash_mask;
+    const IMAGE_EXPORT_DIRECTORY *export_hash_dir; /* export directory the hash table was built for */
+    DWORD                 export_hash_count;
 } WINE_MODREF;
 
 static UINT tls_module_count = 32;     /* number of modules with TLS directory */
@@ -194,10 +199,29 @@ static NTSTATUS process_attach( LDR_DDAG_NODE *node, LPVOID lpReserved );
 static FARPROC find_ordinal_export( HMODULE module, const IMAGE_EXPORT_DIRECTORY *exports,
                                     DWORD exp_size, DWORD ordinal, LPCWSTR load_path,
                                     WINE_MODREF *importer, BOOL is_dynamic );
-static FARPROC find_named_export( HMODULE module, const IMAGE_EXPORT_DIRECTORY *exports, DWORD exp_size,
+static FARPROC find_named_export( WINE_MODREF *exporter, const IMAGE_EXPORT_DIRECTORY *exports, DWORD exp_size,
                                   const char *name, int hint, LPCWSTR load_path,
                                   WINE_MODREF *importer, BOOL is_dynamic );
 
+/* performance counter value to time loader phases with, only queried when the loadtime channel is on */
+static inline LONGLONG loadtime_counter(void)
+{
+    LARGE_INTEGER counter;
+
+    if (!TRACE_ON(loadtime)) return 0;
+    NtQueryPerformanceCounter( &counter, NULL );
+    return counter.QuadPart;
+}
+
+/* microseconds elapsed since a loadtime_counter() value */
+static ULONG loadtime_elapsed( LONGLONG start )
+{
+    LARGE_INTEGER counter, frequency;
+
+    NtQueryPerformanceCounter( &counter, &frequency );
+    return (counter.QuadPart - start) * 1000000 / frequency.QuadPart;
+}
+
 /* check whether the file name contains a path */
 static inline BOOL contains_path( LPCWSTR name )
 {
@@ -996,7 +1020,7 @@ static FARPROC find_forwarded_export( HMODULE module, const char *forward, LPCWS
                                         atoi(name+1) - exports->Base, load_path,
                                         importer, is_dynamic );
         } else
-            proc = find_named_export( wm->ldr.DllBase, exports, exp_size, name, -1, load_path,
+            proc = find_named_export( wm, exports, exp_size, name, -1, load_path,
                                       importer, is_dynamic );
     }
 
@@ -1076,16 +1100,77 @@ static int find_name_in_exports( HMODULE module, const IMAGE_EXPORT_DIRECTORY *e
 }
 
 
+static inline unsigned int hash_export_name( const char *name )
+{
+    unsigned int hash = 5381;
+    while (*name) hash = hash * 33 + (unsigned char)*name++;
+    return hash;
+}
+
+
+/*************************************************************************
+ *		find_name_in_export_hash
+ *
+ * Helper for find_named_export. Lookups that don't match the import hint, typically
+ * because the importer was linked against a different version of the module, go
+ * through a hash table of the exported names built the first time it's needed.
+ * The loader_section must be locked while calling this function.
+ */
+static int find_name_in_export_hash( WINE_MODREF *wm, const IMAGE_EXPORT_DIRECTORY *exports, const char *name )
+{
+    HMODULE module = wm->ldr.DllBase;
+    const WORD *ordinals = get_rva( module, exports->AddressOfNameOrdinals );
+    const DWORD *names = get_rva( module, exports->AddressOfNames );
+    DWORD i, pos, mask;
+
+    if (exports->NumberOfNames < 32 || exports->NumberOfNames > 0x1000000)
+        return find_name_in_exports( module, exports, name );
+
+    if (!wm->export_hash)
+    {
+        DWORD size = 64;
+
+        while (size < exports->NumberOfNames * 2) size *= 2;
+        if (!(wm->export_hash = RtlAllocateHeap( GetProcessHeap(), HEAP_ZERO_MEMORY, size * sizeof(DWORD) )))
+            return find_name_in_exports( module, exports, name );
+        wm->export_hash_mask = mask = size - 1;
+        wm->export_hash_dir = exports;
+        wm->export_hash_count = exports->NumberOfNames;
+
+        /* entries store the name index plus one, zero is an empty slot */
+        for (i = 0; i < exports->NumberOfNames; i++)
+        {
+            pos = hash_export_name( get_rva( module, names[i] ) ) & mask;
+            while (wm->export_hash[pos]) pos = (pos + 1) & mask;
+            wm->export_hash[pos] = i + 1;
+        }
+    }
+
+    /* the table only covers the directory it was built for */
+    if (wm->export_hash_dir != exports || wm->export_hash_count != exports->NumberOfNames)
+        return find_name_in_exports( module, exports, name );
+
+    mask = wm->export_hash_mask;
+    for (pos = hash_export_name( name ) & mask; wm->export_hash[pos]; pos = (pos + 1) & mask)
+    {
+        i = wm->export_hash[pos] - 1;
+        if (!strcmp( get_rva( module, names[i] ), name )) return ordinals[i];
+    }
+    return -1;
+}
+
+
 /*************************************************************************
  *		find_named_export
  *
  * Find an exported function by name.
  * The loader_section must be locked while calling this function.
  */
-static FARPROC find_named_export( HMODULE module, const IMAGE_EXPORT_DIRECTORY *exports, DWORD exp_size,
+static FARPROC find_named_export( WINE_MODREF *exporter, const IMAGE_EXPORT_DIRECTORY *exports, DWORD exp_size,
                                   const char *name, int hint, LPCWSTR load_path, WINE_MODREF *importer,
                                   BOOL is_dynamic )
 {
+    HMODULE module = exporter->ldr.DllBase;
     const WORD *ordinals = get_rva( module, exports->AddressOfNameOrdinals );
     const DWORD *names = get_rva( module, exports->AddressOfNames );
     int ordinal;
@@ -1098,8 +1183,8 @@ static FARPROC find_named_export( HMODULE module, const IMAGE_EXPORT_DIRECTORY *
             return find_ordinal_export( module, exports, exp_size, ordinals[hint], load_path, importer, is_dynamic );
     }
 
-    /* then do a binary search */
-    if ((ordinal = find_name_in_exports( module, exports, name )) == -1) return NULL;
+    /* then look it up by name */
+    if ((ordinal = find_name_in_export_hash( exporter, exports, name )) == -1) return NULL;
     return find_ordinal_export( module, exports, exp_size, ordinal, load_path, importer, is_dynamic );
 
 }
@@ -1241,7 +1326,7 @@ static BOOL import_dll( WINE_MODREF *wm, const IMAGE_IMPORT_DESCRIPTOR *descr, L
         {
             IMAGE_IMPORT_BY_NAME *pe_name;
             pe_name = get_rva( module, (DWORD)import_list->u1.AddressOfData );
-            thunk_list->u1.Function = (ULONG_PTR)find_named_export( imp_mod, exports, exp_size,
+            thunk_list->u1.Function = (ULONG_PTR)find_named_export( wmImp, exports, exp_size,
                                                                     (const char*)pe_name->Name,
                                                                     pe_name->Hint, load_path, wm, FALSE );
             if (!thunk_list->u1.Function)
@@ -1765,6 +1850,7 @@ static NTSTATUS process_attach( LDR_DDAG_NODE *node, LPVOID lpReserved )
     LDR_DATA_TABLE_ENTRY *mod;
     ULONG_PTR cookie;
     WINE_MODREF *wm;
+    LONGLONG start;
 
     if (process_detaching) return status;
 
@@ -1798,7 +1884,10 @@ static NTSTATUS process_attach( LDR_DDAG_NODE *node, LPVOID lpReserved )
     if (status == STATUS_SUCCESS)
     {
         call_ldr_notifications( LDR_DLL_NOTIFICATION_REASON_LOADED, &wm->ldr );
+        start = loadtime_counter();
         status = MODULE_InitDLL( wm, DLL_PROCESS_ATTACH, lpReserved );
+        TRACE_(loadtime)( "%s: initialized in %lu us\n", debugstr_w(wm->ldr.BaseDllName.Buffer),
+                          loadtime_elapsed( start ) );
         if (status == STATUS_SUCCESS)
         {
             wm->ldr.Flags |= LDR_PROCESS_ATTACHED;
@@ -2077,7 +2166,7 @@ NTSTATUS WINAPI LdrGetProcedureAddress(HMODULE module, const ANSI_STRING *name,
     else if ((exports = RtlImageDirectoryEntryToData( module, TRUE,
                                                       IMAGE_DIRECTORY_ENTRY_EXPORT, &exp_size )))
     {
-        void *proc = name ? find_named_export( module, exports, exp_size, name->Buffer, -1, NULL, wm, TRUE )
+        void *proc = name ? find_named_export( wm, exports, exp_size, name->Buffer, -1, NULL, wm, TRUE )
                           : find_ordinal_export( module, exports, exp_size, ord - exports->Base, NULL, wm, TRUE );
         if (proc)
         {
@@ -2259,11 +2348,14 @@ static NTSTATUS build_module( LPCWSTR load_path, const UNICODE_STRING *nt_name,
     WINE_MODREF *wm;
     NTSTATUS status;
     SIZE_T map_size;
+    LONGLONG start;
 
     if (!(nt = RtlImageNtHeader( *module ))) return STATUS_INVALID_IMAGE_FORMAT;
 
     map_size = (nt->OptionalHeader.SizeOfImage + page_size - 1) & ~(page_size - 1);
+    start = loadtime_counter();
     if ((status = perform_relocations( *module, nt, map_size ))) return status;
+    TRACE_(loadtime)( "%s: relocated in %lu us\n", debugstr_us(nt_name), loadtime_elapsed( start ) );
 
     is_builtin = ((char *)nt - signature >= sizeof(builtin_signature) &&
                   !memcmp( signature, builtin_signature, sizeof(builtin_signature) ));
@@ -2286,10 +2378,13 @@ static NTSTATUS build_module( LPCWSTR load_path, const UNICODE_STRING *nt_name,
         ((nt->FileHeader.Characteristics & IMAGE_FILE_DLL) ||
          nt->OptionalHeader.Subsystem == IMAGE_SUBSYSTEM_NATIVE))
     {
+        start = loadtime_counter();
         if (wm->ldr.Flags & LDR_COR_ILONLY)
             status = fixup_imports_ilonly( wm, load_path, &wm->ldr.EntryPoint );
         else
             status = fixup_imports( wm, load_path );
+        TRACE_(loadtime)( "%s: imports resolved in %lu us, including loading dependencies\n",
+                          debugstr_us(nt_name), loadtime_elapsed( start ) );
         if (status != STATUS_SUCCESS)
         {
             /* the module has only be inserted in the load & memory order lists */
@@ -2804,10 +2899,12 @@ static NTSTATUS load_native_dll( LPCWSTR load_path, const UNICODE_STRING *nt_nam
 {
     void *module = NULL;
     SIZE_T len = 0;
+    LONGLONG start = loadtime_counter();
     NTSTATUS status = NtMapViewOfSection( mapping, NtCurrentProcess(), &module, 0, 0, NULL, &len,
                                           ViewShare, 0, PAGE_EXECUTE_READ );
 
     if (!NT_SUCCESS(status)) return status;
+    TRACE_(loadtime)( "%s: mapped in %lu us\n", debugstr_us(nt_name), loadtime_elapsed( start ) );
 
     if ((*pwm = find_existing_module( module )))  /* already loaded */
     {
@@ -4034,6 +4131,7 @@ static void free_modref( WINE_MODREF *wm )
     NtUnmapViewOfSection( NtCurrentProcess(), wm->ldr.DllBase );
     if (cached_modref == wm) cached_modref = NULL;
     RtlFreeUnicodeString( &wm->ldr.FullDllName );
+    RtlFreeHeap( GetProcessHeap(), 0, wm->export_hash );
     RtlFreeHeap( GetProcessHeap(), 0, wm );
 }
 
@@ -188,6 +188,37 @@ static inline unsigned int decode_utf8_char( unsigned char ch, const char **str,
 }
 
 
+/* length of the initial run of 7-bit ASCII chars, checked a word at a time */
+static inline unsigned int get_ascii_run_mbs( const char *src, unsigned int srclen )
+{
+    unsigned int pos = 0;
+    UINT64 word;
+
+    for ( ; pos + sizeof(word) <= srclen; pos += sizeof(word))
+    {
+        memcpy( &word, src + pos, sizeof(word) );
+        if (word & 0x8080808080808080ull) break;
+    }
+    while (pos < srclen && !(src[pos] & 0x80)) pos++;
+    return pos;
+}
+
+
+static inline unsigned int get_ascii_run_wcs( const WCHAR *src, unsigned int srclen )
+{
+    unsigned int pos = 0;
+    UINT64 word;
+
+    for ( ; pos + sizeof(word) / sizeof(WCHAR) <= srclen; pos += sizeof(word) / sizeof(WCHAR))
+    {
+        memcpy( &word, src + pos, sizeof(word) );
+        if (word & 0xff80ff80ff80ff80ull) break;
+    }
+    while (pos < srclen && src[pos] < 0x80) pos++;
+    return pos;
+}
+
+
 static inline void init_codepage_table( USHORT *ptr, CPTABLEINFO *info )
 {
     USHORT hdr_size = ptr[0];
@@ -316,7 +347,13 @@ static inline NTSTATUS utf8_wcstombs_size( const WCHAR *src, unsigned int srclen
 
     for (len = 0; srclen; srclen--, src++)
     {
-        if (*src < 0x80) len++;  /* 0x00-0x7f: 1 byte */
+        if (*src < 0x80)  /* 0x00-0x7f: 1 byte */
+        {
+            unsigned int run = get_ascii_run_wcs( src, srclen );
+            len += run;
+            src += run - 1;
+            srclen -= run - 1;
+        }
         else if (*src < 0x800) len += 2;  /* 0x80-0x7ff: 2 bytes */
         else
         {
@@ -348,7 +385,13 @@ static inline NTSTATUS utf8_mbstowcs_size( const char *src, unsigned int srclen,
     for (len = 0; src < srcend; len++)
     {
         unsigned char ch = *src++;
-        if (ch < 0x80) continue;
+        if (ch < 0x80)
+        {
+            unsigned int run = get_ascii_run_mbs( src, srcend - src );
+            len += run;
+            src += run;
+            continue;
+        }
         if ((res = decode_utf8_char( ch, &src, srcend )) > 0x10ffff)
             status = STATUS_SOME_NOT_MAPPED;
         else
@@ -429,12 +472,16 @@ static inline NTSTATUS utf8_mbstowcs( WCHAR *dst, unsigned int dstlen, unsigned
 
     while ((dst < dstend) && (src < srcend))
     {
-        unsigned char ch = *src++;
+        unsigned char ch = *src;
         if (ch < 0x80)  /* special fast case for 7-bit ASCII */
         {
-            *dst++ = ch;
+            unsigned int i, run = get_ascii_run_mbs( src, min( srcend - src, dstend - dst ));
+            for (i = 0; i < run; i++) dst[i] = (unsigned char)src[i];
+            src += run;
+            dst += run;
             continue;
         }
+        src++;
         if ((res = decode_utf8_char( ch, &src, srcend )) <= 0xffff)
         {
             *dst++ = res;
@@ -475,8 +522,14 @@ static inline NTSTATUS utf8_wcstombs( char *dst, unsigned int dstlen, unsigned i
 
         if (ch < 0x80)  /* 0x00-0x7f: 1 byte */
         {
+            unsigned int i, run;
+
             if (dst > end - 1) break;
-            *dst++ = ch;
+            run = get_ascii_run_wcs( src, min( srclen, end - dst ));
+            for (i = 0; i < run; i++) dst[i] = src[i];
+            dst += run;
+            src += run - 1;
+            srclen -= run - 1;
             continue;
         }
         if (ch < 0x800)  /* 0x80-0x7ff: 2 bytes */
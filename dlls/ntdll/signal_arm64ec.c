@@ -1152,6 +1152,7 @@ NTSTATUS call_seh_handlers( EXCEPTION_RECORD *rec, CONTEXT *orig_context )
     context.AMD64_Context = *orig_context;
     context.ContextFlags &= ~0x40; /* Clear xstate flag. */
 
+    table.Count = 0;
     dispatch.TargetPc      = 0;
     dispatch.ContextRecord = &context.AMD64_Context;
     dispatch.HistoryTable  = &table;
@@ -1823,6 +1824,7 @@ ULONG WINAPI RtlWalkFrameChain( void **buffer, ULONG count, ULONG flags )
     ULONG i, skip = flags >> 8, num_entries = 0;
 
     RtlCaptureContext( &context );
+    table.Count = 0;
 
     for (i = 0; i < count; i++)
     {
@@ -244,6 +244,7 @@ NTSTATUS call_seh_handlers( EXCEPTION_RECORD *rec, CONTEXT *orig_context )
     context = *orig_context;
     context.ContextFlags &= ~0x40; /* Clear xstate flag. */
 
+    table.Count = 0;
     dispatch.TargetIp      = 0;
     dispatch.ContextRecord = &context;
     dispatch.HistoryTable  = &table;
@@ -690,6 +691,7 @@ void WINAPI RtlUnwindEx( PVOID end_frame, PVOID target_ip, EXCEPTION_RECORD *rec
                          PVOID retval, CONTEXT *context, UNWIND_HISTORY_TABLE *table )
 {
     EXCEPTION_REGISTRATION_RECORD *teb_frame = NtCurrentTeb()->Tib.ExceptionList;
+    UNWIND_HISTORY_TABLE local_table;
     EXCEPTION_RECORD record;
     DISPATCHER_CONTEXT dispatch;
     CONTEXT new_context;
@@ -719,6 +721,12 @@ void WINAPI RtlUnwindEx( PVOID end_frame, PVOID target_ip, EXCEPTION_RECORD *rec
         TRACE( " info[%ld]=%016I64x\n", i, rec->ExceptionInformation[i] );
     TRACE_CONTEXT( context );
 
+    if (!table)
+    {
+        local_table.Count = 0;
+        table = &local_table;
+    }
+
     dispatch.EstablisherFrame = context->Rsp;
     dispatch.TargetIp         = (ULONG64)target_ip;
     dispatch.ContextRecord    = context;
@@ -880,6 +888,7 @@ ULONG WINAPI RtlWalkFrameChain( void **buffer, ULONG count, ULONG flags )
     ULONG i, skip = flags >> 8, num_entries = 0;
 
     RtlCaptureContext( &context );
+    table.Count = 0;
 
     for (i = 0; i < count; i++)
     {
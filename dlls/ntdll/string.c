@@ -33,6 +33,7 @@
 #include "winnls.h"
 #include "winternl.h"
 #include "ntdll_misc.h"
+#include "wine/wordscan.h"
 
 
 /* same as wctypes except for TAB, which doesn't have C1_BLANK for some reason... */
@@ -72,9 +73,17 @@ static const unsigned short ctypes[257] =
  */
 void * __cdecl memchr( const void *ptr, int c, size_t n )
 {
+    UINT_PTR mask = WORD_ONES_8 * (unsigned char)c;
     const unsigned char *p = ptr;
+    const UINT_PTR *w;
 
-    for (p = ptr; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (; n && (UINT_PTR)p % sizeof(*w); n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+
+    for (w = (const UINT_PTR *)p; n >= sizeof(*w); w++, n -= sizeof(*w))
+        if (word_has_zero_byte( *w ^ mask )) break;
+
+    for (p = (const unsigned char *)w; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
     return NULL;
 }
 
@@ -358,6 +367,17 @@ errno_t __cdecl strcat_s( char *dst, size_t len, const char *src )
  */
 char * __cdecl strchr( const char *str, int c )
 {
+    UINT_PTR mask = WORD_ONES_8 * (unsigned char)c;
+    const UINT_PTR *w;
+
+    for (; (UINT_PTR)str % sizeof(*w); str++)
+    {
+        if (*str == (char)c) return (char *)(ULONG_PTR)str;
+        if (!*str) return NULL;
+    }
+    for (w = (const UINT_PTR *)str; !word_has_zero_byte( *w ) && !word_has_zero_byte( *w ^ mask ); w++) ;
+
+    str = (const char *)w;
     do { if (*str == (char)c) return (char *)(ULONG_PTR)str; } while (*str++);
     return NULL;
 }
@@ -423,7 +443,11 @@ size_t __cdecl strcspn( const char *str, const char *reject )
 size_t __cdecl strlen( const char *str )
 {
     const char *s = str;
-    while (*s) s++;
+    const UINT_PTR *w;
+
+    for (; (UINT_PTR)s % sizeof(*w); s++) if (!*s) return s - str;
+    for (w = (const UINT_PTR *)s; !word_has_zero_byte( *w ); w++) ;
+    for (s = (const char *)w; *s; s++) ;
     return s - str;
 }
 
@@ -554,7 +578,12 @@ errno_t __cdecl strncpy_s( char *dst, size_t len, const char *src, size_t count
 size_t __cdecl strnlen( const char *str, size_t len )
 {
     const char *s;
-    for (s = str; len && *s; s++, len--) ;
+    const UINT_PTR *w;
+
+    for (s = str; len && (UINT_PTR)s % sizeof(*w); s++, len--) if (!*s) return s - str;
+    for (w = (const UINT_PTR *)s; len >= sizeof(*w); w++, len -= sizeof(*w))
+        if (word_has_zero_byte( *w )) break;
+    for (s = (const char *)w; len && *s; s++, len--) ;
     return s - str;
 }
 
@@ -38,6 +38,25 @@
 
 WINE_DEFAULT_DEBUG_CHANNEL(sync);
 WINE_DECLARE_DEBUG_CHANNEL(relay);
+WINE_DECLARE_DEBUG_CHANNEL(lockstat);
+
+static inline LONGLONG lockstat_counter(void)
+{
+    LARGE_INTEGER counter;
+
+    if (!TRACE_ON(lockstat)) return 0;
+    NtQueryPerformanceCounter( &counter, NULL );
+    return counter.QuadPart;
+}
+
+/* microseconds elapsed since a lockstat_counter() value */
+static ULONG lockstat_elapsed( LONGLONG start )
+{
+    LARGE_INTEGER counter, frequency;
+
+    NtQueryPerformanceCounter( &counter, &frequency );
+    return (counter.QuadPart - start) * 1000000 / frequency.QuadPart;
+}
 
 static const char *debugstr_timeout( const LARGE_INTEGER *timeout )
 {
@@ -298,6 +317,7 @@ NTSTATUS WINAPI RtlDeleteCriticalSection( RTL_CRITICAL_SECTION *crit )
 NTSTATUS WINAPI RtlpWaitForCriticalSection( RTL_CRITICAL_SECTION *crit )
 {
     unsigned int timeout = 5;
+    LONGLONG start;
 
     /* Don't allow blocking on a critical section during process termination */
     if (RtlDllShutdownInProgress())
@@ -307,6 +327,7 @@ NTSTATUS WINAPI RtlpWaitForCriticalSection( RTL_CRITICAL_SECTION *crit )
         return STATUS_SUCCESS;
     }
 
+    start = lockstat_counter();
     for (;;)
     {
         NTSTATUS status = wait_semaphore( crit, timeout );
@@ -320,6 +341,9 @@ NTSTATUS WINAPI RtlpWaitForCriticalSection( RTL_CRITICAL_SECTION *crit )
              crit, debugstr_a(crit_section_get_name(crit)), GetCurrentThreadId(), HandleToULong(crit->OwningThread), timeout );
     }
     if (crit_section_has_debuginfo( crit )) crit->DebugInfo->ContentionCount++;
+    TRACE_(lockstat)( "section %p %s waited %lu us, contention count %lu\n", crit,
+                      debugstr_a(crit_section_get_name(crit)), lockstat_elapsed( start ),
+                      crit_section_has_debuginfo( crit ) ? crit->DebugInfo->ContentionCount : 0 );
     return STATUS_SUCCESS;
 }
 
@@ -488,6 +512,37 @@ struct srw_lock
 };
 C_ASSERT( sizeof(struct srw_lock) == 4 );
 
+/* number of times to check the lock state before waiting, similar to what Windows does */
+#define SRW_SPIN_COUNT 1024
+
+static unsigned int get_srw_spin_count(void)
+{
+    return NtCurrentTeb()->Peb->NumberOfProcessors > 1 ? SRW_SPIN_COUNT : 0;
+}
+
+/* spin while the lock can't be acquired, returns TRUE if it's worth trying again */
+static BOOL spin_srw_lock( struct srw_lock *lock, BOOL exclusive, unsigned int *spin )
+{
+    union { struct srw_lock s; LONG l; } val;
+
+    while (*spin)
+    {
+        (*spin)--;
+        YieldProcessor();
+        val.l = ReadNoFence( (LONG *)lock );
+        if (exclusive ? !val.s.owners : !val.s.exclusive_waiters) return TRUE;
+    }
+    return FALSE;
+}
+
+static void wait_srw_lock( RTL_SRWLOCK *lock, const void *addr, const void *cmp, SIZE_T size )
+{
+    LONGLONG start = lockstat_counter();
+
+    RtlWaitOnAddress( addr, cmp, size, NULL );
+    TRACE_(lockstat)( "lock %p waited %lu us\n", lock, lockstat_elapsed( start ));
+}
+
 /***********************************************************************
  *              RtlInitializeSRWLock (NTDLL.@)
  *
@@ -514,6 +569,7 @@ void WINAPI RtlInitializeSRWLock( RTL_SRWLOCK *lock )
 void WINAPI RtlAcquireSRWLockExclusive( RTL_SRWLOCK *lock )
 {
     union { RTL_SRWLOCK *rtl; struct srw_lock *s; LONG *l; } u = { lock };
+    unsigned int spin = get_srw_spin_count();
 
     InterlockedExchangeAdd16( &u.s->exclusive_waiters, 2 );
 
@@ -542,7 +598,8 @@ void WINAPI RtlAcquireSRWLockExclusive( RTL_SRWLOCK *lock )
         } while (InterlockedCompareExchange( u.l, new.l, old.l ) != old.l);
 
         if (!wait) return;
-        RtlWaitOnAddress( &u.s->owners, &new.s.owners, sizeof(short), NULL );
+        if (spin_srw_lock( u.s, TRUE, &spin )) continue;
+        wait_srw_lock( lock, &u.s->owners, &new.s.owners, sizeof(short) );
     }
 }
 
@@ -556,6 +613,7 @@ void WINAPI RtlAcquireSRWLockExclusive( RTL_SRWLOCK *lock )
 void WINAPI RtlAcquireSRWLockShared( RTL_SRWLOCK *lock )
 {
     union { RTL_SRWLOCK *rtl; struct srw_lock *s; LONG *l; } u = { lock };
+    unsigned int spin = get_srw_spin_count();
 
     for (;;)
     {
@@ -581,7 +639,8 @@ void WINAPI RtlAcquireSRWLockShared( RTL_SRWLOCK *lock )
         } while (InterlockedCompareExchange( u.l, new.l, old.l ) != old.l);
 
         if (!wait) return;
-        RtlWaitOnAddress( u.s, &new.s, sizeof(struct srw_lock), NULL );
+        if (spin_srw_lock( u.s, FALSE, &spin )) continue;
+        wait_srw_lock( lock, u.s, &new.s, sizeof(struct srw_lock) );
     }
 }
 
@@ -829,25 +888,31 @@ struct futex_entry
     DWORD tid;
 };
 
-struct futex_queue
+/* each queue has its own cache line, so that unrelated waiters don't contend on the locks */
+struct DECLSPEC_ALIGN(64) futex_queue
 {
     struct list queue;
     LONG lock;
 };
 
-static struct futex_queue futex_queues[256];
+static struct futex_queue futex_queues[1024];
 
 static struct futex_queue *get_futex_queue( const void *addr )
 {
     ULONG_PTR val = (ULONG_PTR)addr;
 
-    return &futex_queues[(val >> 4) % ARRAY_SIZE(futex_queues)];
+    /* fold in the higher bits, addresses that are a page apart would collide otherwise */
+    val = (val >> 4) ^ (val >> 14) ^ (val >> 24);
+    return &futex_queues[val % ARRAY_SIZE(futex_queues)];
 }
 
 static void spin_lock( LONG *lock )
 {
     while (InterlockedCompareExchange( lock, -1, 0 ))
-        YieldProcessor();
+    {
+        /* only retry once the lock looks free to avoid bouncing the cache line */
+        do YieldProcessor(); while (ReadNoFence( lock ));
+    }
 }
 
 static void spin_unlock( LONG *lock )
@@ -6248,7 +6248,7 @@ static LRESULT unwinding_wnd_proc(HWND w, UINT msg, WPARAM p2, LPARAM p3)
 {
     CONTEXT context;
     int frames;
-    UNWIND_HISTORY_TABLE table;
+    UNWIND_HISTORY_TABLE table = {0};
     RUNTIME_FUNCTION *func;
     ULONG_PTR frame, base;
     void *data;
@@ -2085,6 +2085,9 @@ static const struct unicode_to_utf8_test unicode_to_utf8[] = {
     { { '-',0x00e7,0x0301,'-',0 }, "-\xC3\xA7\xCC\x81-", STATUS_SUCCESS },
     { { '-',0x0063,0x0327,0x0301,'-',0 }, "-\x63\xCC\xA7\xCC\x81-", STATUS_SUCCESS },
     { { '-',0x0063,0x0301,0x0327,'-',0 }, "-\x63\xCC\x81\xCC\xA7-", STATUS_SUCCESS },
+    /* long ASCII runs */
+    { { 'a','b','c','d','e','f','g','h','i',0xe9,'j','k','l','m','n','o','p','q','r',0 },
+      "abcdefghi\xC3\xA9jklmnopqr", STATUS_SUCCESS },
 };
 
 static void utf8_expect_(const unsigned char *out_string, ULONG buflen, ULONG out_bytes,
@@ -2339,6 +2342,11 @@ static const struct utf8_to_unicode_test utf8_to_unicode[] = {
     { "", { 0 }, STATUS_SUCCESS },
     { "-", { '-',0 }, STATUS_SUCCESS },
     { "hello", { 'h','e','l','l','o',0 }, STATUS_SUCCESS },
+    /* long ASCII runs */
+    { "abcdefghi\xC3\xA9jklmnopqr",
+      { 'a','b','c','d','e','f','g','h','i',0xe9,'j','k','l','m','n','o','p','q','r',0 }, STATUS_SUCCESS },
+    { "abcdefghi\x80jklmnopqr",
+      { 'a','b','c','d','e','f','g','h','i',0xfffd,'j','k','l','m','n','o','p','q','r',0 }, STATUS_SOME_NOT_MAPPED },
     /* first and last of each range */
     { "-\x7F-\xC2\x80-\xC3\xBF-\xC4\x80-", { '-',0x7f,'-',0x80,'-',0xff,'-',0x100,'-',0 }, STATUS_SUCCESS },
     { "-\xDF\xBF-\xE0\xA0\x80-", { '-',0x7ff,'-',0x800,'-',0 }, STATUS_SUCCESS },
@@ -3622,6 +3622,47 @@ static void test_virtual_unwind_x86(void)
     ok( bret, "RtlDeleteFunctionTable failed.\n"  );
 }
 
+static void test_unwind_history_table(void)
+{
+    UNWIND_HISTORY_TABLE table = { 0 };
+    RUNTIME_FUNCTION *func, *func2, copy;
+    ULONG_PTR pc = (ULONG_PTR)pRtlLookupFunctionEntry, base, base2;
+
+    if (!pRtlLookupFunctionEntry)
+    {
+        win_skip( "RtlLookupFunctionEntry not found\n" );
+        return;
+    }
+
+    func = pRtlLookupFunctionEntry( pc, &base, NULL );
+    ok( func != NULL, "no function found for %Ix\n", pc );
+    if (!func) return;
+
+    base2 = 0xdeadbeef;
+    func2 = pRtlLookupFunctionEntry( pc, &base2, &table );
+    ok( func2 == func, "got %p, expected %p\n", func2, func );
+    ok( base2 == base, "got base %Ix, expected %Ix\n", base2, base );
+    ok( table.Count == 1, "got count %lu\n", table.Count );
+    if (table.Count != 1) return;
+    ok( table.Entry[0].ImageBase == base, "got base %Ix, expected %Ix\n", table.Entry[0].ImageBase, base );
+    ok( table.Entry[0].FunctionEntry == func, "got %p, expected %p\n", table.Entry[0].FunctionEntry, func );
+    ok( table.LowAddress <= pc && pc < table.HighAddress, "got range %Ix-%Ix for %Ix\n",
+        table.LowAddress, table.HighAddress, pc );
+
+    /* a subsequent lookup is satisfied from the table */
+    copy = *func;
+    table.Entry[0].FunctionEntry = &copy;
+    base2 = 0xdeadbeef;
+    func2 = pRtlLookupFunctionEntry( pc, &base2, &table );
+    ok( func2 == &copy, "got %p, expected %p\n", func2, &copy );
+    ok( base2 == base, "got base %Ix, expected %Ix\n", base2, base );
+    ok( table.Count == 1, "got count %lu\n", table.Count );
+
+    /* addresses outside of the table range are looked up normally */
+    func2 = pRtlLookupFunctionEntry( (ULONG_PTR)test_unwind_history_table, &base2, &table );
+    ok( func2 != NULL && func2 != &copy, "got %p\n", func2 );
+}
+
 #endif  /* __x86_64__ */
 
 #ifdef __x86_64__
@@ -3649,9 +3690,9 @@ static void test_dynamic_unwind(void)
     static const int code_offset = 1024;
     char buf[2 * sizeof(RUNTIME_FUNCTION) + 4];
     MEM_EXTENDED_PARAMETER param = { 0 };
-    RUNTIME_FUNCTION *runtime_func, *func;
+    RUNTIME_FUNCTION *runtime_func, *func, funcs_a[2], funcs_b[1], funcs_c[2];
     ULONG_PTR table, base, ec_code;
-    void *growable_table, *ptr;
+    void *growable_table, *table_a, *table_b, *table_c, *ptr;
     NTSTATUS status;
     SIZE_T size = 0x1000;
     DWORD count;
@@ -3858,6 +3899,64 @@ static void test_dynamic_unwind(void)
 
     pRtlDeleteGrowableFunctionTable( growable_table );
 
+    /* Overlapping and nested tables, the first registered one is used */
+    funcs_a[0].BeginAddress = 0x100;
+    funcs_a[0].UnwindData   = 0;
+    SET_RUNTIME_FUNC_LEN( &funcs_a[0], 16 );
+    funcs_a[1].BeginAddress = 0x1a0;
+    funcs_a[1].UnwindData   = 0;
+    SET_RUNTIME_FUNC_LEN( &funcs_a[1], 16 );
+    funcs_b[0].BeginAddress = 0x80;
+    funcs_b[0].UnwindData   = 0;
+    SET_RUNTIME_FUNC_LEN( &funcs_b[0], 16 );
+    memcpy( funcs_c, funcs_a, sizeof(funcs_c) );
+
+    table_a = table_b = table_c = NULL;
+    status = pRtlAddGrowableFunctionTable( &table_a, funcs_a, 2, 2, (ULONG_PTR)code_mem, (ULONG_PTR)code_mem + 0x200 );
+    ok( !status, "RtlAddGrowableFunctionTable failed %lx\n", status );
+    status = pRtlAddGrowableFunctionTable( &table_b, funcs_b, 1, 1, (ULONG_PTR)code_mem + 0x80,
+                                           (ULONG_PTR)code_mem + 0x180 );
+    ok( !status, "RtlAddGrowableFunctionTable failed %lx\n", status );
+    /* same base as the first table */
+    status = pRtlAddGrowableFunctionTable( &table_c, funcs_c, 2, 2, (ULONG_PTR)code_mem, (ULONG_PTR)code_mem + 0x200 );
+    ok( !status, "RtlAddGrowableFunctionTable failed %lx\n", status );
+
+    base = 0xdeadbeef;
+    func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 0x108, &base, NULL );
+    ok( func == &funcs_a[0] || broken(func == &funcs_b[0] || func == &funcs_c[0]),
+        "RtlLookupFunctionEntry got %p, expected %p\n", func, &funcs_a[0] );
+    ok( base == (ULONG_PTR)code_mem || broken(base == (ULONG_PTR)code_mem + 0x80),
+        "RtlLookupFunctionEntry got base %Ix\n", base );
+
+    /* outside of the nested table */
+    func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 0x1a8, &base, NULL );
+    ok( func == &funcs_a[1] || broken(func == &funcs_c[1]),
+        "RtlLookupFunctionEntry got %p, expected %p\n", func, &funcs_a[1] );
+    ok( base == (ULONG_PTR)code_mem, "RtlLookupFunctionEntry got base %Ix\n", base );
+
+    /* deleting the first table leaves the others in registration order */
+    pRtlDeleteGrowableFunctionTable( table_a );
+    base = 0xdeadbeef;
+    func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 0x108, &base, NULL );
+    ok( func == &funcs_b[0] || broken(func == &funcs_c[0]),
+        "RtlLookupFunctionEntry got %p, expected %p\n", func, &funcs_b[0] );
+    ok( base == (ULONG_PTR)code_mem + 0x80 || broken(base == (ULONG_PTR)code_mem),
+        "RtlLookupFunctionEntry got base %Ix\n", base );
+    func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 0x1a8, &base, NULL );
+    ok( func == &funcs_c[1], "RtlLookupFunctionEntry got %p, expected %p\n", func, &funcs_c[1] );
+
+    /* deleting the table in the middle of the address range */
+    pRtlDeleteGrowableFunctionTable( table_b );
+    base = 0xdeadbeef;
+    func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 0x108, &base, NULL );
+    ok( func == &funcs_c[0], "RtlLookupFunctionEntry got %p, expected %p\n", func, &funcs_c[0] );
+    ok( base == (ULONG_PTR)code_mem, "RtlLookupFunctionEntry got base %Ix\n", base );
+
+    pRtlDeleteGrowableFunctionTable( table_c );
+    base = 0xdeadbeef;
+    func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 0x108, &base, NULL );
+    ok( func == NULL, "RtlLookupFunctionEntry got %p\n", func );
+
     param.Type = MemExtendedParameterAttributeFlags;
     param.ULong64 = MEM_EXTENDED_PARAMETER_EC_CODE;
     ec_code = 0;
@@ -3961,6 +4060,7 @@ START_TEST(unwind)
 #elif defined(__x86_64__)
     test_virtual_unwind_x86();
     test_virtual_unwind_arm64();
+    test_unwind_history_table();
 #endif
 
     test_dynamic_unwind();
@@ -219,7 +219,7 @@ struct dir_data_buffer
 struct dir_data_names
 {
     const WCHAR *long_name;          /* long file name in Unicode */
-    const WCHAR *short_name;         /* short file name in Unicode */
+    const WCHAR *short_name;         /* short file name in Unicode, NULL if not generated yet */
     const char  *unix_name;          /* Unix file name in host encoding */
 };
 
@@ -554,7 +554,8 @@ static BOOL add_dir_data_names( struct dir_data *data, const WCHAR *long_name,
         data->names = names;
     }
 
-    if (short_name[0])
+    if (!short_name) names[data->count].short_name = NULL;
+    else if (short_name[0])
     {
         if (!(names[data->count].short_name = add_dir_data_nameW( data, short_name ))) return FALSE;
     }
@@ -1582,6 +1583,23 @@ static BOOLEAN is_legal_8dot3_name( const WCHAR *name, int len )
 }
 
 
+/***********************************************************************
+ *           generate_short_name
+ *
+ * Generate the short name of a file, empty if the long name is already a valid 8.3 name.
+ */
+static int generate_short_name( const WCHAR *long_name, int long_len, WCHAR short_name[13] )
+{
+    int len = 0;
+
+    if (!is_legal_8dot3_name( long_name, long_len ))
+        len = hash_short_file_name( long_name, long_len, short_name );
+    short_name[len] = 0;
+    wcsupr( short_name );
+    return len;
+}
+
+
 /***********************************************************************
  *           append_entry
  *
@@ -1590,7 +1608,7 @@ static BOOLEAN is_legal_8dot3_name( const WCHAR *name, int len )
 static BOOL append_entry( struct dir_data *data, const char *long_name,
                           const char *short_name, const UNICODE_STRING *mask )
 {
-    int long_len, short_len;
+    int long_len, short_len = -1;
     WCHAR long_nameW[MAX_DIR_ENTRY_LEN + 1];
     WCHAR short_nameW[13];
 
@@ -1603,26 +1621,22 @@ static BOOL append_entry( struct dir_data *data, const char *long_name,
     {
         short_len = ntdll_umbstowcs( short_name, strlen(short_name),
                                      short_nameW, ARRAY_SIZE( short_nameW ) - 1 );
+        short_nameW[short_len] = 0;
+        wcsupr( short_nameW );
     }
-    else  /* generate a short name if necessary */
-    {
-        short_len = 0;
-        if (!is_legal_8dot3_name( long_nameW, long_len ))
-            short_len = hash_short_file_name( long_nameW, long_len, short_nameW );
-    }
-    short_nameW[short_len] = 0;
-    wcsupr( short_nameW );
 
-    TRACE( "long %s short %s mask %s\n",
-           debugstr_w( long_nameW ), debugstr_w( short_nameW ), debugstr_us( mask ));
+    TRACE( "long %s short %s mask %s\n", debugstr_w( long_nameW ),
+           short_len >= 0 ? debugstr_w( short_nameW ) : "(lazy)", debugstr_us( mask ));
 
     if (mask && !match_filename( long_nameW, long_len, mask ))
     {
+        if (short_len < 0) short_len = generate_short_name( long_nameW, long_len, short_nameW );
         if (!short_len) return TRUE;  /* no short name to match */
         if (!match_filename( short_nameW, short_len, mask )) return TRUE;
     }
 
-    return add_dir_data_names( data, long_nameW, short_nameW, long_name );
+    /* otherwise the short name is only generated once an information class needs it */
+    return add_dir_data_names( data, long_nameW, short_len >= 0 ? short_nameW : NULL, long_name );
 }
 
 
@@ -2461,6 +2475,8 @@ static NTSTATUS get_dir_data_entry( struct dir_data *dir_data, void *info_ptr, I
     union file_directory_info *info;
     struct stat st;
     ULONG name_len, start, dir_size, attributes, reparse_tag;
+    const WCHAR *short_name = names->short_name;
+    WCHAR short_nameW[13];
 
     if (get_file_info( names->unix_name, &st, &attributes, &reparse_tag ) == -1)
     {
@@ -2492,6 +2508,13 @@ static NTSTATUS get_dir_data_entry( struct dir_data *dir_data, void *info_ptr, I
         fill_file_info( &st, attributes, info, class );
     }
 
+    if (!short_name && (class == FileBothDirectoryInformation || class == FileIdBothDirectoryInformation ||
+                        class == FileIdExtdBothDirectoryInformation))
+    {
+        generate_short_name( names->long_name, wcslen( names->long_name ), short_nameW );
+        short_name = short_nameW;
+    }
+
     switch (class)
     {
     case FileDirectoryInformation:
@@ -2511,15 +2534,15 @@ static NTSTATUS get_dir_data_entry( struct dir_data *dir_data, void *info_ptr, I
 
     case FileBothDirectoryInformation:
         info->both.EaSize = reparse_tag;
-        info->both.ShortNameLength = wcslen( names->short_name ) * sizeof(WCHAR);
-        memcpy( info->both.ShortName, names->short_name, info->both.ShortNameLength );
+        info->both.ShortNameLength = wcslen( short_name ) * sizeof(WCHAR);
+        memcpy( info->both.ShortName, short_name, info->both.ShortNameLength );
         info->both.FileNameLength = name_len;
         break;
 
     case FileIdBothDirectoryInformation:
         info->id_both.EaSize = reparse_tag;
-        info->id_both.ShortNameLength = wcslen( names->short_name ) * sizeof(WCHAR);
-        memcpy( info->id_both.ShortName, names->short_name, info->id_both.ShortNameLength );
+        info->id_both.ShortNameLength = wcslen( short_name ) * sizeof(WCHAR);
+        memcpy( info->id_both.ShortName, short_name, info->id_both.ShortNameLength );
         info->id_both.FileNameLength = name_len;
         break;
 
@@ -2527,8 +2550,8 @@ static NTSTATUS get_dir_data_entry( struct dir_data *dir_data, void *info_ptr, I
         /* Extd classes do *not* return the reparse tag in EaSize */
         info->extd_both.EaSize = 0; /* FIXME */
         info->extd_both.ReparsePointTag = reparse_tag;
-        info->extd_both.ShortNameLength = wcslen( names->short_name ) * sizeof(WCHAR);
-        memcpy( info->extd_both.ShortName, names->short_name, info->extd_both.ShortNameLength );
+        info->extd_both.ShortNameLength = wcslen( short_name ) * sizeof(WCHAR);
+        memcpy( info->extd_both.ShortName, short_name, info->extd_both.ShortNameLength );
         info->extd_both.FileNameLength = name_len;
         break;
 
@@ -25,6 +25,7 @@
 #include "config.h"
 
 #include <assert.h>
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <stdarg.h>
@@ -1118,6 +1119,124 @@ static NTSTATUS open_builtin_pe_file( const char *name, OBJECT_ATTRIBUTES *attr,
 }
 
 
+/* cached contents of the builtin dll directories, to avoid probing for files that don't exist */
+struct builtin_dir
+{
+    char        *path;
+    char       **names;   /* sorted file names */
+    unsigned int count;
+    BOOL         listed;  /* whether the contents are known */
+};
+
+static struct builtin_dir *builtin_dirs;
+static unsigned int builtin_dirs_count;
+static unsigned int builtin_dirs_size;
+static unsigned int builtin_probes;          /* number of files looked up in the cache */
+static unsigned int builtin_probes_skipped;  /* number of them that didn't need a syscall */
+static pthread_mutex_t builtin_dirs_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int builtin_name_cmp( const void *a, const void *b )
+{
+    return strcmp( *(const char * const *)a, *(const char * const *)b );
+}
+
+static void list_builtin_dir( struct builtin_dir *dir )
+{
+    unsigned int size = 0;
+    struct dirent *de;
+    char **names;
+    DIR *d;
+
+    if (!(d = opendir( dir->path )))
+    {
+        /* a missing directory is known to be empty */
+        dir->listed = (errno == ENOENT || errno == ENOTDIR);
+        return;
+    }
+
+    dir->listed = TRUE;
+    while ((de = readdir( d )))
+    {
+        if (de->d_name[0] == '.') continue;
+        if (dir->count == size)
+        {
+            size = max( 64, size * 2 );
+            if (!(names = realloc( dir->names, size * sizeof(*names) ))) break;
+            dir->names = names;
+        }
+        if (!(dir->names[dir->count] = strdup( de->d_name ))) break;
+        dir->count++;
+    }
+    if (de)  /* out of memory */
+    {
+        while (dir->count) free( dir->names[--dir->count] );
+        free( dir->names );
+        dir->names = NULL;
+        dir->listed = FALSE;
+    }
+    closedir( d );
+
+    if (dir->count) qsort( dir->names, dir->count, sizeof(*dir->names), builtin_name_cmp );
+    TRACE( "%s: %u files\n", debugstr_a(dir->path), dir->count );
+}
+
+static struct builtin_dir *get_builtin_dir( const char *path, size_t len )
+{
+    struct builtin_dir *dir;
+    unsigned int i;
+
+    for (i = 0; i < builtin_dirs_count; i++)
+        if (!strncmp( builtin_dirs[i].path, path, len ) && !builtin_dirs[i].path[len]) return &builtin_dirs[i];
+
+    if (builtin_dirs_count == builtin_dirs_size)
+    {
+        unsigned int new_size = max( 8, builtin_dirs_size * 2 );
+        struct builtin_dir *new_dirs;
+
+        if (!(new_dirs = realloc( builtin_dirs, new_size * sizeof(*new_dirs) ))) return NULL;
+        builtin_dirs = new_dirs;
+        builtin_dirs_size = new_size;
+    }
+
+    dir = &builtin_dirs[builtin_dirs_count];
+    memset( dir, 0, sizeof(*dir) );
+    if (!(dir->path = malloc( len + 1 ))) return NULL;
+    memcpy( dir->path, path, len );
+    dir->path[len] = 0;
+    list_builtin_dir( dir );
+    builtin_dirs_count++;
+    return dir;
+}
+
+/***********************************************************************
+ *           builtin_file_exists
+ *
+ * Check in the cached directory contents whether a file in a builtin dll directory
+ * exists. Returns TRUE if it's not known.
+ */
+static BOOL builtin_file_exists( const char *name, const char *ext )
+{
+    const char *file = strrchr( name, '/' );
+    char buffer[MAX_PATH], *key = buffer;
+    struct builtin_dir *dir;
+    BOOL ret = TRUE;
+
+    if (!file || strlen( file + 1 ) + strlen( ext ) >= sizeof(buffer)) return TRUE;
+    strcpy( buffer, file + 1 );
+    strcat( buffer, ext );
+
+    mutex_lock( &builtin_dirs_mutex );
+    if ((dir = get_builtin_dir( name, file - name )) && dir->listed)
+        ret = dir->count && bsearch( &key, dir->names, dir->count, sizeof(*dir->names), builtin_name_cmp );
+    builtin_probes++;
+    if (!ret) builtin_probes_skipped++;
+    TRACE( "%s ext %s: %s, %u of %u probes skipped\n", debugstr_a(name), debugstr_a(ext), ret ? "probing" : "skipped",
+           builtin_probes_skipped, builtin_probes );
+    mutex_unlock( &builtin_dirs_mutex );
+    return ret;
+}
+
+
 /***********************************************************************
  *           find_builtin_dll
  */
@@ -1207,27 +1326,32 @@ static NTSTATUS find_builtin_dll( UNICODE_STRING *nt_name, ANSI_STRING *exp_name
         ptr = file + pos;
         ptr = prepend( ptr, pe_dir, strlen(pe_dir) );
         ptr = prepend( ptr, dll_paths[i], strlen(dll_paths[i]) );
-        status = open_builtin_pe_file( ptr, &attr, module, size_ptr, image_info, limit_low, limit_high,
-                                       load_machine, prefer_native, offset );
+        status = STATUS_DLL_NOT_FOUND;
+        if (builtin_file_exists( ptr, "" ))
+            status = open_builtin_pe_file( ptr, &attr, module, size_ptr, image_info, limit_low, limit_high,
+                                           load_machine, prefer_native, offset );
         /* use so dir for unix lib */
         ptr = file + pos;
         ptr = prepend( ptr, so_dir, strlen(so_dir) );
         ptr = prepend( ptr, dll_paths[i], strlen(dll_paths[i]) );
         if (status != STATUS_DLL_NOT_FOUND) goto done;
-        status = open_builtin_so_file( ptr, &attr, module, image_info,
-                                       search_machine, load_machine, prefer_native );
+        if (builtin_file_exists( ptr, ".so" ))
+            status = open_builtin_so_file( ptr, &attr, module, image_info,
+                                           search_machine, load_machine, prefer_native );
         if (status != STATUS_DLL_NOT_FOUND) goto done;
         ptr = prepend( file + pos, dll_paths[i], strlen(dll_paths[i]) );
-        status = open_builtin_pe_file( ptr, &attr, module, size_ptr, image_info, limit_low, limit_high,
-                                       load_machine, prefer_native, offset );
+        if (builtin_file_exists( ptr, "" ))
+            status = open_builtin_pe_file( ptr, &attr, module, size_ptr, image_info, limit_low, limit_high,
+                                           load_machine, prefer_native, offset );
         if (status == STATUS_NOT_SUPPORTED)
         {
             found_image = TRUE;
             continue;
         }
         if (status != STATUS_DLL_NOT_FOUND) goto done;
-        status = open_builtin_so_file( ptr, &attr, module, image_info,
-                                       search_machine, load_machine, prefer_native );
+        if (builtin_file_exists( ptr, ".so" ))
+            status = open_builtin_so_file( ptr, &attr, module, image_info,
+                                           search_machine, load_machine, prefer_native );
         if (status == STATUS_NOT_SUPPORTED) found_image = TRUE;
         else if (status != STATUS_DLL_NOT_FOUND) goto done;
     }
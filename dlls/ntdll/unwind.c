@@ -70,41 +70,137 @@ struct dynamic_unwind_entry
 
 static struct list dynamic_unwind_list = LIST_INIT(dynamic_unwind_list);
 
-static RTL_CRITICAL_SECTION dynamic_unwind_section;
-static RTL_CRITICAL_SECTION_DEBUG dynamic_unwind_debug =
+/* index of the dynamic tables sorted by base address, used for lookups */
+struct dynamic_unwind_range
 {
-    0, 0, &dynamic_unwind_section,
-    { &dynamic_unwind_debug.ProcessLocksList, &dynamic_unwind_debug.ProcessLocksList },
-      0, 0, { (DWORD_PTR)(__FILE__ ": dynamic_unwind_section") }
+    ULONG_PTR                    base;
+    ULONG_PTR                    max_end;  /* highest end address of this and all the preceding ranges */
+    unsigned int                 serial;   /* registration order, the first registered table wins */
+    struct dynamic_unwind_entry *entry;
 };
-static RTL_CRITICAL_SECTION dynamic_unwind_section = { &dynamic_unwind_debug, -1, 0, 0, 0, 0 };
 
+static struct dynamic_unwind_range *dynamic_unwind_ranges;
+static unsigned int dynamic_unwind_count;
+static unsigned int dynamic_unwind_size;
+static unsigned int dynamic_unwind_serial;
+
+static RTL_SRWLOCK dynamic_unwind_lock = RTL_SRWLOCK_INIT;
+
+/* return the index of the first range with a base above addr */
+static unsigned int find_dynamic_range( ULONG_PTR addr )
+{
+    unsigned int min = 0, max = dynamic_unwind_count;
+
+    while (min < max)
+    {
+        unsigned int pos = (min + max) / 2;
+        if (dynamic_unwind_ranges[pos].base <= addr) min = pos + 1;
+        else max = pos;
+    }
+    return min;
+}
+
+static void update_dynamic_ranges( unsigned int pos )
+{
+    ULONG_PTR max_end = pos ? dynamic_unwind_ranges[pos - 1].max_end : 0;
+
+    for ( ; pos < dynamic_unwind_count; pos++)
+    {
+        max_end = max( max_end, dynamic_unwind_ranges[pos].entry->end );
+        dynamic_unwind_ranges[pos].max_end = max_end;
+    }
+}
+
+/* add an entry to the list and the index; dynamic_unwind_lock must be held exclusively */
+static BOOL add_dynamic_entry( struct dynamic_unwind_entry *entry )
+{
+    unsigned int pos;
+
+    if (dynamic_unwind_count == dynamic_unwind_size)
+    {
+        unsigned int new_size = max( 16, dynamic_unwind_size * 2 );
+        struct dynamic_unwind_range *new_ranges;
+
+        if (dynamic_unwind_ranges)
+            new_ranges = RtlReAllocateHeap( GetProcessHeap(), 0, dynamic_unwind_ranges,
+                                            new_size * sizeof(*new_ranges) );
+        else
+            new_ranges = RtlAllocateHeap( GetProcessHeap(), 0, new_size * sizeof(*new_ranges) );
+        if (!new_ranges) return FALSE;
+        dynamic_unwind_ranges = new_ranges;
+        dynamic_unwind_size = new_size;
+    }
+
+    pos = find_dynamic_range( entry->base );
+    memmove( dynamic_unwind_ranges + pos + 1, dynamic_unwind_ranges + pos,
+             (dynamic_unwind_count - pos) * sizeof(*dynamic_unwind_ranges) );
+    dynamic_unwind_ranges[pos].base   = entry->base;
+    dynamic_unwind_ranges[pos].serial = dynamic_unwind_serial++;
+    dynamic_unwind_ranges[pos].entry  = entry;
+    dynamic_unwind_count++;
+    update_dynamic_ranges( pos );
+
+    list_add_tail( &dynamic_unwind_list, &entry->entry );
+    return TRUE;
+}
+
+/* remove an entry from the list and the index; dynamic_unwind_lock must be held exclusively */
+static void remove_dynamic_entry( struct dynamic_unwind_entry *entry )
+{
+    unsigned int pos = find_dynamic_range( entry->base );
+
+    while (pos--)
+    {
+        if (dynamic_unwind_ranges[pos].entry != entry) continue;
+        memmove( dynamic_unwind_ranges + pos, dynamic_unwind_ranges + pos + 1,
+                 (dynamic_unwind_count - pos - 1) * sizeof(*dynamic_unwind_ranges) );
+        dynamic_unwind_count--;
+        update_dynamic_ranges( pos );
+        break;
+    }
+    list_remove( &entry->entry );
+}
 
 static RUNTIME_FUNCTION *lookup_dynamic_function_table( ULONG_PTR pc, ULONG_PTR *base, ULONG *count )
 {
-    struct dynamic_unwind_entry *entry;
+    PGET_RUNTIME_FUNCTION_CALLBACK callback = NULL;
+    struct dynamic_unwind_range *found = NULL;
     RUNTIME_FUNCTION *ret = NULL;
+    void *context = NULL;
+    unsigned int pos;
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
+    RtlAcquireSRWLockShared( &dynamic_unwind_lock );
+    pos = find_dynamic_range( pc );
+    /* overlapping tables are resolved in registration order */
+    while (pos-- && pc < dynamic_unwind_ranges[pos].max_end)
+    {
+        if (pc >= dynamic_unwind_ranges[pos].entry->end) continue;
+        if (!found || dynamic_unwind_ranges[pos].serial < found->serial) found = &dynamic_unwind_ranges[pos];
+    }
+    if (found)
     {
-        if (pc >= entry->base && pc < entry->end)
+        struct dynamic_unwind_entry *entry = found->entry;
+
+        *base = entry->base;
+        if (entry->callback)
         {
-            *base = entry->base;
-            if (entry->callback)
-            {
-                ret = entry->callback( pc, entry->context );
-                *count = 1;
-            }
-            else
-            {
-                ret = entry->table;
-                *count = entry->count;
-            }
-            break;
+            callback = entry->callback;
+            context = entry->context;
+        }
+        else
+        {
+            ret = entry->table;
+            *count = entry->count;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlReleaseSRWLockShared( &dynamic_unwind_lock );
+
+    /* the callback may add or remove tables itself */
+    if (callback)
+    {
+        ret = callback( pc, context );
+        *count = 1;
+    }
     return ret;
 }
 
@@ -117,6 +213,7 @@ BOOLEAN CDECL RtlInstallFunctionTableCallback( ULONG_PTR table, ULONG_PTR base,
                                                PCWSTR dll )
 {
     struct dynamic_unwind_entry *entry;
+    BOOL ret;
 
     TRACE( "%Ix %Ix %ld %p %p %s\n", table, base, length, callback, context, wine_dbgstr_w(dll) );
 
@@ -138,11 +235,12 @@ BOOLEAN CDECL RtlInstallFunctionTableCallback( ULONG_PTR table, ULONG_PTR base,
     entry->callback  = callback;
     entry->context   = context;
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    list_add_tail( &dynamic_unwind_list, &entry->entry );
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
+    ret = add_dynamic_entry( entry );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 
-    return TRUE;
+    if (!ret) RtlFreeHeap( GetProcessHeap(), 0, entry );
+    return ret;
 }
 
 
@@ -153,6 +251,7 @@ NTSTATUS WINAPI RtlAddGrowableFunctionTable( void **table, RUNTIME_FUNCTION *fun
                                              DWORD max_count, ULONG_PTR base, ULONG_PTR end )
 {
     struct dynamic_unwind_entry *entry;
+    BOOL ret;
 
     TRACE( "%p, %p, %lu, %lu, %Ix, %Ix\n", table, functions, count, max_count, base, end );
 
@@ -168,10 +267,15 @@ NTSTATUS WINAPI RtlAddGrowableFunctionTable( void **table, RUNTIME_FUNCTION *fun
     entry->callback  = NULL;
     entry->context   = NULL;
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    list_add_tail( &dynamic_unwind_list, &entry->entry );
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
+    ret = add_dynamic_entry( entry );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 
+    if (!ret)
+    {
+        RtlFreeHeap( GetProcessHeap(), 0, entry );
+        return STATUS_NO_MEMORY;
+    }
     *table = entry;
 
     return STATUS_SUCCESS;
@@ -187,7 +291,7 @@ void WINAPI RtlGrowFunctionTable( void *table, DWORD count )
 
     TRACE( "%p, %lu\n", table, count );
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
     LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
     {
         if (entry == table)
@@ -197,7 +301,7 @@ void WINAPI RtlGrowFunctionTable( void *table, DWORD count )
             break;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 }
 
 
@@ -210,17 +314,17 @@ void WINAPI RtlDeleteGrowableFunctionTable( void *table )
 
     TRACE( "%p\n", table );
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
     LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
     {
         if (entry == table)
         {
             to_free = entry;
-            list_remove( &entry->entry );
+            remove_dynamic_entry( entry );
             break;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 
     RtlFreeHeap( GetProcessHeap(), 0, to_free );
 }
@@ -235,17 +339,17 @@ BOOLEAN CDECL RtlDeleteFunctionTable( RUNTIME_FUNCTION *table )
 
     TRACE( "%p\n", table );
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
     LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
     {
         if (entry->table == table)
         {
             to_free = entry;
-            list_remove( &entry->entry );
+            remove_dynamic_entry( entry );
             break;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 
     if (!to_free) return FALSE;
 
@@ -2295,6 +2399,46 @@ EXCEPTION_DISPOSITION WINAPI __C_specific_handler( EXCEPTION_RECORD *rec, void *
 }
 
 
+/* look for the function among the ones already found during the current unwind */
+static RUNTIME_FUNCTION *lookup_history_table( UNWIND_HISTORY_TABLE *table, ULONG_PTR pc, ULONG_PTR *base )
+{
+    DWORD i;
+
+    if (!table->Count || table->Count > UNWIND_HISTORY_TABLE_SIZE) return NULL;
+    if (pc < table->LowAddress || pc >= table->HighAddress) return NULL;
+
+    for (i = 0; i < table->Count; i++)
+    {
+        RUNTIME_FUNCTION *func = table->Entry[i].FunctionEntry;
+        ULONG_PTR image_base = table->Entry[i].ImageBase;
+
+        if (pc < image_base + func->BeginAddress || pc >= image_base + func->EndAddress) continue;
+        *base = image_base;
+        return func;
+    }
+    return NULL;
+}
+
+static void add_history_table_entry( UNWIND_HISTORY_TABLE *table, ULONG_PTR base, RUNTIME_FUNCTION *func )
+{
+    ULONG_PTR start = base + func->BeginAddress, end = base + func->EndAddress;
+
+    if (table->Count >= UNWIND_HISTORY_TABLE_SIZE) return;
+    if (!table->Count)
+    {
+        table->LowAddress = start;
+        table->HighAddress = end;
+    }
+    else
+    {
+        table->LowAddress = min( table->LowAddress, start );
+        table->HighAddress = max( table->HighAddress, end );
+    }
+    table->Entry[table->Count].ImageBase = base;
+    table->Entry[table->Count].FunctionEntry = func;
+    table->Count++;
+}
+
 /**********************************************************************
  *              RtlLookupFunctionEntry   (NTDLL.@)
  */
@@ -2310,13 +2454,23 @@ PRUNTIME_FUNCTION WINAPI RtlLookupFunctionEntry( ULONG_PTR pc, ULONG_PTR *base,
         return (RUNTIME_FUNCTION *)RtlLookupFunctionEntry_arm64( pc, base, table );
 #endif
 
+    if (table && (func = lookup_history_table( table, pc, base ))) return func;
+
     if ((func = RtlLookupFunctionTable( pc, base, &size )))
-        return find_function_info( pc, *base, func, size / sizeof(*func));
+    {
+        if ((func = find_function_info( pc, *base, func, size / sizeof(*func) )) && table)
+            add_history_table_entry( table, *base, func );
+        return func;
+    }
 
     if ((func = lookup_dynamic_function_table( pc, &dynbase, &size )))
     {
         RUNTIME_FUNCTION *ret = find_function_info( pc, dynbase, func, size );
-        if (ret) *base = dynbase;
+        if (ret)
+        {
+            *base = dynbase;
+            if (table) add_history_table_entry( table, dynbase, ret );
+        }
         return ret;
     }
 
@@ -33,6 +33,7 @@
 #include "winnls.h"
 #include "winternl.h"
 #include "ntdll_misc.h"
+#include "wine/wordscan.h"
 
 static const unsigned short wctypes[256] =
 {
@@ -215,7 +216,12 @@ errno_t __cdecl wcscpy_s( wchar_t *dst, size_t len, const wchar_t *src )
 size_t __cdecl wcslen( LPCWSTR str )
 {
     const WCHAR *s = str;
-    while (*s) s++;
+    const UINT_PTR *w;
+
+    /* strings that are not WCHAR aligned never reach word alignment */
+    for (; (UINT_PTR)s % sizeof(*w); s++) if (!*s) return s - str;
+    for (w = (const UINT_PTR *)s; !word_has_zero_wchar( *w ); w++) ;
+    for (s = (const WCHAR *)w; *s; s++) ;
     return s - str;
 }
 
@@ -408,7 +414,13 @@ errno_t __cdecl wcsncpy_s( wchar_t *dst, size_t len, const wchar_t *src, size_t
 size_t __cdecl wcsnlen( const WCHAR *str, size_t len )
 {
     const WCHAR *s;
-    for (s = str; len && *s; s++, len--) ;
+    const UINT_PTR *w;
+
+    /* strings that are not WCHAR aligned never reach word alignment */
+    for (s = str; len && (UINT_PTR)s % sizeof(*w); s++, len--) if (!*s) return s - str;
+    for (w = (const UINT_PTR *)s; len >= sizeof(*w) / sizeof(*s); w++, len -= sizeof(*w) / sizeof(*s))
+        if (word_has_zero_wchar( *w )) break;
+    for (s = (const WCHAR *)w; len && *s; s++, len--) ;
     return s - str;
 }
 
@@ -1277,6 +1277,12 @@ typedef struct tagTLBContext
 	void *mapping;        /* memory mapping */
 	MSFT_SegDir * pTblDir;
 	ITypeLibImpl* pLibInfo;
+	TLBGuid **guids;      /* guid table entries, indexed by entry */
+	TLBString **names;    /* name table entries, indexed by offset / 4 */
+	TLBString **strings;  /* string table entries, indexed by offset / 4 */
+	unsigned int guid_count;
+	unsigned int name_count;
+	unsigned int string_count;
 } TLBContext;
 
 
@@ -2074,6 +2080,16 @@ static HRESULT MSFT_ReadAllGuids(TLBContext *pcx)
     MSFT_GuidEntry entry;
     int offs = 0;
 
+    if (pcx->pTblDir->pGuidTab.length > 0)
+    {
+        pcx->guid_count = pcx->pTblDir->pGuidTab.length / sizeof(MSFT_GuidEntry) + 1;
+        if (!(pcx->guids = calloc(pcx->guid_count, sizeof(*pcx->guids))))
+        {
+            pcx->guid_count = 0;
+            return E_OUTOFMEMORY;
+        }
+    }
+
     MSFT_Seek(pcx, pcx->pTblDir->pGuidTab.offset);
     while (1) {
         if (offs >= pcx->pTblDir->pGuidTab.length)
@@ -2088,6 +2104,7 @@ static HRESULT MSFT_ReadAllGuids(TLBContext *pcx)
         guid->hreftype = entry.hreftype;
 
         list_add_tail(&pcx->pLibInfo->guid_list, &guid->entry);
+        pcx->guids[offs / sizeof(MSFT_GuidEntry)] = guid;
 
         offs += sizeof(MSFT_GuidEntry);
     }
@@ -2097,14 +2114,12 @@ static TLBGuid *MSFT_ReadGuid( int offset, TLBContext *pcx)
 {
     TLBGuid *ret;
 
-    LIST_FOR_EACH_ENTRY(ret, &pcx->pLibInfo->guid_list, TLBGuid, entry){
-        if(ret->offset == offset){
-            TRACE_(typelib)("%s\n", debugstr_guid(&ret->guid));
-            return ret;
-        }
-    }
+    if (offset < 0 || offset % sizeof(MSFT_GuidEntry)) return NULL;
+    if (offset / sizeof(MSFT_GuidEntry) >= pcx->guid_count) return NULL;
+    if (!(ret = pcx->guids[offset / sizeof(MSFT_GuidEntry)])) return NULL;
 
-    return NULL;
+    TRACE_(typelib)("%s\n", debugstr_guid(&ret->guid));
+    return ret;
 }
 
 static HREFTYPE MSFT_ReadHreftype( TLBContext *pcx, int offset )
@@ -2130,6 +2145,16 @@ static HRESULT MSFT_ReadAllNames(TLBContext *pcx)
     INT16 len_piece;
     int offs = 0, lengthInChars;
 
+    if (pcx->pTblDir->pNametab.length > 0)
+    {
+        pcx->name_count = pcx->pTblDir->pNametab.length / 4 + 1;
+        if (!(pcx->names = calloc(pcx->name_count, sizeof(*pcx->names))))
+        {
+            pcx->name_count = 0;
+            return E_OUTOFMEMORY;
+        }
+    }
+
     MSFT_Seek(pcx, pcx->pTblDir->pNametab.offset);
     while (1) {
         TLBString *tlbstr;
@@ -2165,6 +2190,7 @@ static HRESULT MSFT_ReadAllNames(TLBContext *pcx)
         free(string);
 
         list_add_tail(&pcx->pLibInfo->name_list, &tlbstr->entry);
+        pcx->names[offs / 4] = tlbstr;
 
         offs += len_piece;
     }
@@ -2174,28 +2200,22 @@ static TLBString *MSFT_ReadName( TLBContext *pcx, int offset)
 {
     TLBString *tlbstr;
 
-    LIST_FOR_EACH_ENTRY(tlbstr, &pcx->pLibInfo->name_list, TLBString, entry) {
-        if (tlbstr->offset == offset) {
-            TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
-            return tlbstr;
-        }
-    }
+    if (offset < 0 || offset % 4 || offset / 4 >= pcx->name_count) return NULL;
+    if (!(tlbstr = pcx->names[offset / 4])) return NULL;
 
-    return NULL;
+    TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
+    return tlbstr;
 }
 
 static TLBString *MSFT_ReadString( TLBContext *pcx, int offset)
 {
     TLBString *tlbstr;
 
-    LIST_FOR_EACH_ENTRY(tlbstr, &pcx->pLibInfo->string_list, TLBString, entry) {
-        if (tlbstr->offset == offset) {
-            TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
-            return tlbstr;
-        }
-    }
+    if (offset < 0 || offset % 4 || offset / 4 >= pcx->string_count) return NULL;
+    if (!(tlbstr = pcx->strings[offset / 4])) return NULL;
 
-    return NULL;
+    TRACE_(typelib)("%s\n", debugstr_w(tlbstr->str));
+    return tlbstr;
 }
 
 /*
@@ -2762,6 +2782,16 @@ static HRESULT MSFT_ReadAllStrings(TLBContext *pcx)
     INT16 len_str, len_piece;
     int offs = 0, lengthInChars;
 
+    if (pcx->pTblDir->pStringtab.length > 0)
+    {
+        pcx->string_count = pcx->pTblDir->pStringtab.length / 4 + 1;
+        if (!(pcx->strings = calloc(pcx->string_count, sizeof(*pcx->strings))))
+        {
+            pcx->string_count = 0;
+            return E_OUTOFMEMORY;
+        }
+    }
+
     MSFT_Seek(pcx, pcx->pTblDir->pStringtab.offset);
     while (1) {
         TLBString *tlbstr;
@@ -2796,6 +2826,7 @@ static HRESULT MSFT_ReadAllStrings(TLBContext *pcx)
         free(string);
 
         list_add_tail(&pcx->pLibInfo->string_list, &tlbstr->entry);
+        pcx->strings[offs / 4] = tlbstr;
 
         offs += len_piece;
     }
@@ -3449,6 +3480,10 @@ static ITypeLib2* ITypeLib2_Constructor_MSFT(LPVOID pLib, DWORD dwTLBLength)
     cx.mapping = pLib;
     cx.pLibInfo = pTypeLibImpl;
     cx.length = dwTLBLength;
+    cx.guids = NULL;
+    cx.names = NULL;
+    cx.strings = NULL;
+    cx.guid_count = cx.name_count = cx.string_count = 0;
 
     /* read header */
     MSFT_ReadLEDWords(&tlbHeader, sizeof(tlbHeader), &cx, 0);
@@ -3640,6 +3675,10 @@ static ITypeLib2* ITypeLib2_Constructor_MSFT(LPVOID pLib, DWORD dwTLBLength)
             TLB_fix_typeinfo_ptr_size(pTypeLibImpl->typeinfos[i]);
     }
 
+    free(cx.guids);
+    free(cx.names);
+    free(cx.strings);
+
     TRACE("(%p)\n", pTypeLibImpl);
     return &pTypeLibImpl->ITypeLib2_iface;
 }
@@ -425,6 +425,85 @@ static int rpcrt4_conn_np_write(RpcConnection *conn, const void *buffer, unsigne
     return count;
 }
 
+static RPC_STATUS rpcrt4_ncalrpc_receive_fragment(RpcConnection *conn, RpcPktHdr **Header, void **Payload)
+{
+    RpcPktCommonHdr *common_hdr;
+    unsigned char *buffer, *new_buffer;
+    unsigned int size = RPC_MAX_PACKET_SIZE;
+    RPC_STATUS status;
+    DWORD hdr_length;
+    LONG count, ret;
+
+    *Header = NULL;
+    *Payload = NULL;
+
+    TRACE("(%p, %p, %p)\n", conn, Header, Payload);
+
+    /* the pipe is in message mode and every fragment is written as a single
+     * message, so fetch it with one read instead of reading the header and
+     * the payload separately */
+    if (!(buffer = malloc(size)))
+        return RPC_S_OUT_OF_RESOURCES;
+
+    count = rpcrt4_conn_np_read(conn, buffer, size);
+    if (count < (LONG)sizeof(*common_hdr))
+    {
+        WARN("Short read of header, %ld bytes\n", count);
+        status = RPC_S_CALL_FAILED;
+        goto fail;
+    }
+
+    common_hdr = (RpcPktCommonHdr *)buffer;
+    status = RPCRT4_ValidateCommonHeader(common_hdr);
+    if (status != RPC_S_OK) goto fail;
+
+    hdr_length = RPCRT4_GetHeaderSize((RpcPktHdr *)common_hdr);
+    if (hdr_length == 0)
+    {
+        WARN("header length == 0\n");
+        status = RPC_S_PROTOCOL_ERROR;
+        goto fail;
+    }
+
+    if (count == size && common_hdr->frag_len > size)
+    {
+        /* the rest of the message is still queued in the pipe */
+        if (!(new_buffer = realloc(buffer, common_hdr->frag_len)))
+        {
+            status = RPC_S_OUT_OF_RESOURCES;
+            goto fail;
+        }
+        buffer = new_buffer;
+        common_hdr = (RpcPktCommonHdr *)buffer;
+        ret = rpcrt4_conn_np_read(conn, buffer + count, common_hdr->frag_len - count);
+        if (ret > 0) count += ret;
+    }
+
+    if (count != common_hdr->frag_len || count < hdr_length)
+    {
+        WARN("bad data length, %ld/%d, hdr_length %ld\n", count, common_hdr->frag_len, hdr_length);
+        status = RPC_S_CALL_FAILED;
+        goto fail;
+    }
+
+    if (count - hdr_length)
+    {
+        if (!(*Payload = malloc(count - hdr_length)))
+        {
+            status = RPC_S_OUT_OF_RESOURCES;
+            goto fail;
+        }
+        memcpy(*Payload, buffer + hdr_length, count - hdr_length);
+    }
+
+    *Header = (RpcPktHdr *)buffer;
+    return RPC_S_OK;
+
+fail:
+    free(buffer);
+    return status;
+}
+
 static int rpcrt4_conn_np_close(RpcConnection *conn)
 {
     RpcConnection_np *connection = (RpcConnection_np *) conn;
@@ -3153,7 +3232,7 @@ static const struct connection_ops conn_protseq_list[] = {
     rpcrt4_conn_np_wait_for_incoming_data,
     rpcrt4_ncalrpc_get_top_of_tower,
     rpcrt4_ncalrpc_parse_top_of_tower,
-    NULL,
+    rpcrt4_ncalrpc_receive_fragment,
     rpcrt4_ncalrpc_is_authorized,
     rpcrt4_ncalrpc_authorize,
     rpcrt4_ncalrpc_secure_packet,
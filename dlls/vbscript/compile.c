@@ -456,6 +456,35 @@ static BOOL lookup_dim_decls(compile_ctx_t *ctx, const WCHAR *name)
     return FALSE;
 }
 
+/* Returns TRUE if the name refers to a variable or an argument of the function being compiled,
+ * which can be accessed by its index without looking the name up when the code runs. */
+static BOOL lookup_local_slot(compile_ctx_t *ctx, const WCHAR *name, vbsop_t *op, unsigned *idx)
+{
+    dim_decl_t *dim_decl;
+    unsigned i;
+
+    if(ctx->func->type == FUNC_GLOBAL || (ctx->func->name && !vbs_wcsicmp(ctx->func->name, name)))
+        return FALSE;
+
+    for(dim_decl = ctx->dim_decls, i = 0; dim_decl; dim_decl = dim_decl->next, i++) {
+        if(!vbs_wcsicmp(dim_decl->name, name)) {
+            *op = OP_local;
+            *idx = i;
+            return TRUE;
+        }
+    }
+
+    for(i = 0; i < ctx->func->arg_cnt; i++) {
+        if(!vbs_wcsicmp(ctx->func->args[i].name, name)) {
+            *op = OP_local_arg;
+            *idx = i;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
 static HRESULT compile_args(compile_ctx_t *ctx, expression_t *args, unsigned *ret)
 {
     unsigned arg_cnt = 0;
@@ -506,10 +535,15 @@ static HRESULT compile_member_call_expression(compile_ctx_t *ctx, member_express
 static HRESULT compile_member_expression(compile_ctx_t *ctx, member_expression_t *expr)
 {
     expression_t *const_expr;
+    unsigned idx;
+    vbsop_t op;
 
     if (expr->obj_expr) /* FIXME: we should probably have a dedicated opcode as well */
         return compile_member_call_expression(ctx, expr, 0, TRUE);
 
+    if (lookup_local_slot(ctx, expr->identifier, &op, &idx))
+        return push_instr_uint(ctx, op, idx);
+
     if (!lookup_dim_decls(ctx, expr->identifier) && !lookup_args_name(ctx, expr->identifier)) {
         const_expr = lookup_const_decls(ctx, expr->identifier, TRUE);
         if(const_expr)
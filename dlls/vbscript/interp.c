@@ -873,6 +873,35 @@ static HRESULT interp_mcallv(exec_ctx_t *ctx)
     return do_mcall(ctx, NULL);
 }
 
+static HRESULT push_local_ref(exec_ctx_t *ctx, VARIANT *var)
+{
+    VARIANT v;
+
+    V_VT(&v) = VT_BYREF|VT_VARIANT;
+    V_BYREF(&v) = V_VT(var) == (VT_VARIANT|VT_BYREF) ? V_VARIANTREF(var) : var;
+    return stack_push(ctx, &v);
+}
+
+static HRESULT interp_local(exec_ctx_t *ctx)
+{
+    const unsigned idx = ctx->instr->arg1.uint;
+
+    assert(idx < ctx->func->var_cnt);
+    TRACE("%s\n", debugstr_w(ctx->func->vars[idx].name));
+
+    return push_local_ref(ctx, ctx->vars + idx);
+}
+
+static HRESULT interp_local_arg(exec_ctx_t *ctx)
+{
+    const unsigned idx = ctx->instr->arg1.uint;
+
+    assert(idx < ctx->func->arg_cnt);
+    TRACE("%s\n", debugstr_w(ctx->func->args[idx].name));
+
+    return push_local_ref(ctx, ctx->args + idx);
+}
+
 static HRESULT interp_ident(exec_ctx_t *ctx)
 {
     BSTR identifier = ctx->instr->arg1.bstr;
@@ -50,6 +50,9 @@ typedef struct
 #define COMPRESS_ALGORITHM_XPRESS       3
 #define COMPRESS_ALGORITHM_XPRESS_HUFF  4
 #define COMPRESS_ALGORITHM_LZMS         5
+#define COMPRESS_ALGORITHM_MAX          6
+
+#define COMPRESS_RAW                    (1 << 29)
 
 /**********************************************************************/
 
@@ -0,0 +1,42 @@
+/*
+ * Word-at-a-time string scanning helpers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __WINE_WINE_WORDSCAN_H
+#define __WINE_WINE_WORDSCAN_H
+
+/* aligned word reads never cross a page boundary, so a string can be
+ * scanned a word at a time without reading past the end of its page */
+
+#define WORD_ONES_8   (~(UINT_PTR)0 / 0xff)
+#define WORD_HIGHS_8  (WORD_ONES_8 << 7)
+#define WORD_ONES_16  (~(UINT_PTR)0 / 0xffff)
+#define WORD_HIGHS_16 (WORD_ONES_16 << 15)
+
+/* non-zero if any byte of the word is zero */
+static inline UINT_PTR word_has_zero_byte( UINT_PTR w )
+{
+    return (w - WORD_ONES_8) & ~w & WORD_HIGHS_8;
+}
+
+/* non-zero if any 16-bit unit of the word is zero */
+static inline UINT_PTR word_has_zero_wchar( UINT_PTR w )
+{
+    return (w - WORD_ONES_16) & ~w & WORD_HIGHS_16;
+}
+
+#endif  /* __WINE_WINE_WORDSCAN_H */
@@ -986,9 +986,14 @@ static void message_queue_read( struct pipe_end *pipe_end, struct async *async )
     }
 
     message = LIST_ENTRY( list_head(&pipe_end->message_queue), struct pipe_message, entry );
-    if (!message->read_pos && message->iosb->in_size == iosb->out_size) /* fast path */
+    if (message->read_pos + out_size == message->iosb->in_size) /* fast path */
     {
-        async_request_complete( async, status, out_size, out_size, message->iosb->in_data );
+        /* the read consumes exactly the rest of the first message, hand its buffer over to
+         * the reader instead of allocating and copying a new one */
+        char *data = message->iosb->in_data;
+
+        if (message->read_pos) memmove( data, data + message->read_pos, out_size );
+        async_request_complete( async, status, out_size, out_size, data );
         message->iosb->in_data = NULL;
         wake_message( message, message->iosb->in_size );
         free_message( message );